@@ -0,0 +1,91 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/accumulator/tree_accumulator.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/image/graph_image.hpp"
+#include "xtensor/xrandom.hpp"
+#include <functional>
+
+using namespace xt;
+using namespace hg;
+
+static std::size_t min_image_size = 7;
+static std::size_t max_image_size = 10;
+static std::size_t vectorial_size = 64;
+
+/**
+ * Canonical binary partition tree of a random image of size x size pixels.
+ */
+static tree get_random_bpt(std::size_t size) {
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+    auto res = bpt_canonical(graph, edge_weights);
+    return std::move(res.tree);
+}
+
+/**
+ * Reference sum accumulator calling its reducer through a std::function (implementation used by
+ * accumulator_sum before the introduction of compile time reducers).
+ */
+struct accumulator_sum_std_function {
+
+    template<bool vectorial = true, typename S>
+    auto make_accumulator(S &storage) const {
+        using value_type = typename S::value_type;
+        using iterator_type = decltype(storage.begin());
+        using reducer_type = std::function<value_type(value_type, value_type)>;
+        return accumulator_detail::acc_marginal_impl<iterator_type, reducer_type, vectorial>(
+                storage.begin(),
+                storage.end(),
+                std::plus<value_type>(),
+                0);
+    }
+
+    template<typename shape_t>
+    static
+    auto get_output_shape(const shape_t &input_shape) {
+        return input_shape;
+    }
+};
+
+template<typename accumulator_t>
+static void BM_accumulate_sequential_scalar(benchmark::State &state) {
+    auto t = get_random_bpt(state.range(0));
+    array_1d<double> leaf_data = xt::random::rand<double>({t.num_leaves()});
+    for (auto _ : state) {
+        auto res = accumulate_sequential(t, leaf_data, accumulator_t(), tree_accumulator_execution::sequential);
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_accumulate_sequential_scalar, accumulator_sum)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
+BENCHMARK_TEMPLATE(BM_accumulate_sequential_scalar, accumulator_sum_std_function)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
+
+template<typename accumulator_t>
+static void BM_accumulate_sequential_vectorial(benchmark::State &state) {
+    auto t = get_random_bpt(state.range(0));
+    array_2d<double> leaf_data = xt::random::rand<double>({t.num_leaves(), vectorial_size});
+    for (auto _ : state) {
+        auto res = accumulate_sequential(t, leaf_data, accumulator_t(), tree_accumulator_execution::sequential);
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_accumulate_sequential_vectorial, accumulator_sum)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
+BENCHMARK_TEMPLATE(BM_accumulate_sequential_vectorial, accumulator_sum_std_function)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
@@ -0,0 +1,83 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/hierarchy/binary_partition_tree.hpp"
+#include "higra/image/graph_image.hpp"
+#include "xtensor/xrandom.hpp"
+
+using namespace xt;
+using namespace hg;
+
+/*
+ * Generic binary partition tree engine (binary_partition_tree) with the complete, average and Ward linkage rules
+ * on the 4-adjacency graph of a random image of size x size pixels. Complete and average linkage are also computed
+ * with the reciprocal nearest neighbours engine (binary_partition_tree_reciprocal_nearest_neighbours).
+ */
+
+static std::size_t min_image_size = 7;
+static std::size_t max_image_size = 10;
+
+static void BM_binary_partition_tree_complete_linkage(benchmark::State &state, bpt_linkage_algorithm algorithm) {
+    std::size_t size = state.range(0);
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+
+    for (auto _ : state) {
+        auto res = binary_partition_tree_complete_linkage(graph, edge_weights, algorithm);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+}
+
+BENCHMARK_CAPTURE(BM_binary_partition_tree_complete_linkage, heap, bpt_linkage_algorithm::heap)
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_binary_partition_tree_complete_linkage, reciprocal_nearest_neighbours,
+                  bpt_linkage_algorithm::reciprocal_nearest_neighbours)
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
+
+static void BM_binary_partition_tree_average_linkage(benchmark::State &state, bpt_linkage_algorithm algorithm) {
+    std::size_t size = state.range(0);
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+    array_1d<double> edge_weight_weights = xt::ones<double>({num_edges(graph)});
+
+    for (auto _ : state) {
+        auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, algorithm);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+}
+
+BENCHMARK_CAPTURE(BM_binary_partition_tree_average_linkage, heap, bpt_linkage_algorithm::heap)
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_binary_partition_tree_average_linkage, reciprocal_nearest_neighbours,
+                  bpt_linkage_algorithm::reciprocal_nearest_neighbours)
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
+
+static void BM_binary_partition_tree_ward_linkage(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_2d<double> vertex_centroids = xt::random::rand<double>({num_vertices(graph), (std::size_t) 3});
+    array_1d<double> vertex_sizes = xt::ones<double>({num_vertices(graph)});
+
+    for (auto _ : state) {
+        auto res = binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+}
+
+BENCHMARK(BM_binary_partition_tree_ward_linkage)
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,82 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/hierarchy/component_tree.hpp"
+#include "xtensor/xrandom.hpp"
+
+#ifdef HG_USE_TBB
+#include "tbb/task_arena.h"
+#endif
+
+using namespace xt;
+using namespace hg;
+
+/*
+ * Max tree of a random 16 bits 3d volume of size x size x size voxels with the 6-adjacency, computed with the
+ * sequential and with the parallel algorithms. If higra is built with TBB, the parallel algorithm is run with 1 to 64
+ * threads (second benchmark argument).
+ */
+
+static std::size_t min_volume_size = 6;
+static std::size_t max_volume_size = 8;
+
+static auto make_volume_graph(std::size_t size) {
+    std::vector<point_3d_i> neighbours{{{-1, 0,  0}},
+                                       {{0,  -1, 0}},
+                                       {{0,  0,  -1}},
+                                       {{0,  0,  1}},
+                                       {{0,  1,  0}},
+                                       {{1,  0,  0}}};
+    return regular_grid_graph_3d(embedding_grid_3d{(index_t) size, (index_t) size, (index_t) size}, neighbours);
+}
+
+static void BM_component_tree_max_tree_sequential(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = make_volume_graph(size);
+    xt::random::seed(42);
+    array_1d<uint16_t> vertex_weights = xt::random::randint<uint16_t>({num_vertices(graph)}, 0, 65535);
+
+    for (auto _ : state) {
+        auto res = component_tree_max_tree(graph, vertex_weights, component_tree_algorithm::sequential);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+}
+
+BENCHMARK(BM_component_tree_max_tree_sequential)
+        ->RangeMultiplier(2)->Range(1 << min_volume_size, 1 << max_volume_size)->Unit(benchmark::kMillisecond);
+
+static void BM_component_tree_max_tree_parallel(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = make_volume_graph(size);
+    xt::random::seed(42);
+    array_1d<uint16_t> vertex_weights = xt::random::randint<uint16_t>({num_vertices(graph)}, 0, 65535);
+
+#ifdef HG_USE_TBB
+    tbb::task_arena arena((int) state.range(1));
+    for (auto _ : state) {
+        arena.execute([&]() {
+            auto res = component_tree_max_tree(graph, vertex_weights, component_tree_algorithm::parallel);
+            benchmark::DoNotOptimize(res.altitudes.data());
+        });
+    }
+#else
+    for (auto _ : state) {
+        auto res = component_tree_max_tree(graph, vertex_weights, component_tree_algorithm::parallel);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+#endif
+}
+
+BENCHMARK(BM_component_tree_max_tree_parallel)
+        ->RangeMultiplier(2)->Ranges({{1 << min_volume_size, 1 << max_volume_size}, {1, 64}})
+        ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,91 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/image/graph_image.hpp"
+#include "higra/algo/graph_weights.hpp"
+#include "xtensor/xrandom.hpp"
+
+using namespace xt;
+using namespace hg;
+
+/*
+ * Edge weights of the 8-adjacency graph of a RGB image: predefined weight functions on an explicit ugraph and on an
+ * implicit grid_graph_2d, compared to a user defined weighting function computing the same L2 distance.
+ */
+
+static std::size_t min_image_size = 9;
+static std::size_t max_image_size = 11;
+
+static array_3d<double> random_rgb_image(std::size_t size) {
+    xt::random::seed(42);
+    return xt::random::rand<double>({size, size, (std::size_t) 3});
+}
+
+template<typename graph_t>
+static void BM_weight_graph_L2(benchmark::State &state, const graph_t &graph, const array_3d<double> &image) {
+    for (auto _ : state) {
+        auto weights = weight_graph(graph, image, weight_functions::L2);
+        benchmark::DoNotOptimize(weights.data());
+    }
+}
+
+static void BM_weight_graph_L2_ugraph(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_8_adjacency_graph({(index_t) size, (index_t) size});
+    BM_weight_graph_L2(state, graph, random_rgb_image(size));
+}
+
+static void BM_weight_graph_L2_grid_graph_2d(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_8_adjacency_grid_graph({(index_t) size, (index_t) size});
+    BM_weight_graph_L2(state, graph, random_rgb_image(size));
+}
+
+static void BM_weight_graph_L2_function(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_8_adjacency_graph({(index_t) size, (index_t) size});
+    auto image = random_rgb_image(size);
+    auto view = xt::reshape_view(image, {size * size, (std::size_t) 3});
+    std::function<double(index_t, index_t)> fun = [&view](index_t i, index_t j) {
+        double res = 0;
+        for (index_t k = 0; k < 3; k++) {
+            auto tmp = view(i, k) - view(j, k);
+            res += tmp * tmp;
+        }
+        return std::sqrt(res);
+    };
+    for (auto _ : state) {
+        auto weights = weight_graph(graph, fun);
+        benchmark::DoNotOptimize(weights.data());
+    }
+}
+
+static void BM_weight_graph_mean_grid_graph_2d(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_8_adjacency_grid_graph({(index_t) size, (index_t) size});
+    xt::random::seed(42);
+    array_2d<double> image = xt::random::rand<double>({size, size});
+    for (auto _ : state) {
+        auto weights = weight_graph(graph, image, weight_functions::mean);
+        benchmark::DoNotOptimize(weights.data());
+    }
+}
+
+BENCHMARK(BM_weight_graph_L2_ugraph)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(
+        benchmark::kMillisecond);
+BENCHMARK(BM_weight_graph_L2_grid_graph_2d)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(
+        benchmark::kMillisecond);
+BENCHMARK(BM_weight_graph_L2_function)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(
+        benchmark::kMillisecond);
+BENCHMARK(BM_weight_graph_mean_grid_graph_2d)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(
+        benchmark::kMillisecond);
@@ -0,0 +1,84 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/image/graph_image.hpp"
+#include "higra/hierarchy/watershed_hierarchy.hpp"
+#include "xtensor/xrandom.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace xt;
+using namespace hg;
+
+/*
+ * Watershed hierarchy by area on a 4-adjacency graph represented either by an explicit ugraph or by an implicit
+ * grid_graph_2d.
+ *
+ * Besides the timings, each benchmark reports the number of heap allocations and the number of allocated bytes
+ * of one iteration, graph construction included. With grid_graph_2d, the number of allocations does not depend
+ * on the image size: no adjacency list is allocated, neither for the input graph nor for the minimum spanning tree.
+ */
+
+static std::atomic<std::size_t> num_allocations{0};
+static std::atomic<std::size_t> num_allocated_bytes{0};
+
+void *operator new(std::size_t size) {
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+    num_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+static std::size_t min_image_size = 9;
+static std::size_t max_image_size = 12;
+
+template<typename graph_factory_t>
+static void BM_watershed_hierarchy_by_area(benchmark::State &state, const graph_factory_t &graph_factory) {
+    std::size_t size = state.range(0);
+    embedding_grid_2d embedding{(index_t) size, (index_t) size};
+    xt::random::seed(42);
+    array_1d<float> edge_weights = xt::random::rand<float>({(size_t) (2 * size * (size - 1))});
+
+    std::size_t allocations = 0;
+    std::size_t allocated_bytes = 0;
+    for (auto _ : state) {
+        std::size_t a0 = num_allocations.load();
+        std::size_t b0 = num_allocated_bytes.load();
+        auto graph = graph_factory(embedding);
+        auto res = watershed_hierarchy_by_area(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+        allocations = num_allocations.load() - a0;
+        allocated_bytes = num_allocated_bytes.load() - b0;
+    }
+    state.counters["allocations"] = allocations;
+    state.counters["allocated_MB"] = allocated_bytes / (1024. * 1024.);
+}
+
+BENCHMARK_CAPTURE(BM_watershed_hierarchy_by_area, ugraph,
+                  [](const embedding_grid_2d &e) { return get_4_adjacency_graph(e); })
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_watershed_hierarchy_by_area, grid_graph_2d,
+                  [](const embedding_grid_2d &e) { return get_4_adjacency_grid_graph(e); })
+        ->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,114 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/image/graph_image.hpp"
+#include "higra/structure/unionfind.hpp"
+#include "xtensor/xrandom.hpp"
+
+using namespace xt;
+using namespace hg;
+
+/*
+ * Compare the cost of the main index bound loops when indices are stored on 32 bits or on 64 bits
+ * (see HG_USE_32BIT_INDEX).
+ */
+
+static std::size_t min_image_size = 9;
+static std::size_t max_image_size = 11;
+
+/**
+ * Parent array of the canonical binary partition tree of a random image of size x size pixels.
+ */
+template<typename idx_t>
+static array_1d<idx_t> get_random_bpt_parents(std::size_t size) {
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+    auto res = bpt_canonical(graph, edge_weights);
+    return xt::cast<idx_t>(res.tree.parents());
+}
+
+/**
+ * Sources and targets of the edges of a 4-adjacency graph of size x size pixels, in random order.
+ */
+template<typename idx_t>
+static std::pair<array_1d<idx_t>, array_1d<idx_t>> get_random_edges(std::size_t size) {
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_1d<index_t> order = xt::arange<index_t>(num_edges(graph));
+    xt::random::shuffle(order);
+    array_1d<idx_t> sources = array_1d<idx_t>::from_shape({num_edges(graph)});
+    array_1d<idx_t> targets = array_1d<idx_t>::from_shape({num_edges(graph)});
+    for (index_t i = 0; i < (index_t) order.size(); i++) {
+        auto e = edge_from_index(order(i), graph);
+        sources(i) = (idx_t) source(e, graph);
+        targets(i) = (idx_t) target(e, graph);
+    }
+    return {std::move(sources), std::move(targets)};
+}
+
+template<typename idx_t>
+static void BM_union_find(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto edges = get_random_edges<idx_t>(size);
+    auto &sources = edges.first;
+    auto &targets = edges.second;
+    for (auto _ : state) {
+        union_find_internal::union_find<idx_t> uf(size * size);
+        for (index_t i = 0; i < (index_t) sources.size(); i++) {
+            auto c1 = uf.find(sources(i));
+            auto c2 = uf.find(targets(i));
+            if (c1 != c2) {
+                uf.link(c1, c2);
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_union_find, int32_t)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
+BENCHMARK_TEMPLATE(BM_union_find, int64_t)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
+
+/*
+ * Area and depth of each node: one bottom-up and one top-down pass through the parent array.
+ */
+template<typename idx_t>
+static void BM_parent_traversal(benchmark::State &state) {
+    auto parents = get_random_bpt_parents<idx_t>(state.range(0));
+    index_t num_nodes = parents.size();
+    index_t num_leaves = (num_nodes + 1) / 2;
+    array_1d<idx_t> area = array_1d<idx_t>::from_shape({(size_t) num_nodes});
+    array_1d<idx_t> depth = array_1d<idx_t>::from_shape({(size_t) num_nodes});
+    for (auto _ : state) {
+        std::fill(area.begin(), area.begin() + num_leaves, 1);
+        std::fill(area.begin() + num_leaves, area.end(), 0);
+        for (index_t i = 0; i < num_nodes - 1; i++) {
+            area(parents(i)) += area(i);
+        }
+        depth(num_nodes - 1) = 0;
+        for (index_t i = num_nodes - 2; i >= 0; i--) {
+            depth(i) = depth(parents(i)) + 1;
+        }
+        benchmark::DoNotOptimize(area.data());
+        benchmark::DoNotOptimize(depth.data());
+    }
+    state.SetBytesProcessed(state.iterations() * num_nodes * 5 * sizeof(idx_t));
+}
+
+BENCHMARK_TEMPLATE(BM_parent_traversal, int32_t)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
+BENCHMARK_TEMPLATE(BM_parent_traversal, int64_t)->RangeMultiplier(2)->Range(
+        1 << min_image_size, 1 << max_image_size);
@@ -11,6 +11,7 @@
 #include <benchmark/benchmark.h>
 
 #include "higra/graph.hpp"
+#include "higra/sorting.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xrandom.hpp"
 #include <algorithm>
@@ -84,4 +85,35 @@ static void BM_tbb_parallel_stable_sort(benchmark::State &state) {
     }
 }
 
-BENCHMARK(BM_tbb_parallel_stable_sort)->Range(1 << min_array_size, 1 << max_array_size);
\ No newline at end of file
+BENCHMARK(BM_tbb_parallel_stable_sort)->Range(1 << min_array_size, 1 << max_array_size);
+
+template<typename value_t>
+static void BM_comparison_stable_arg_sort(benchmark::State &state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        size_t size = state.range(0);
+        array_1d<value_t> a = xt::random::randint<int>({size}, 0, 256);
+        state.ResumeTiming();
+        array_1d<index_t> res = xt::arange<index_t>((index_t) size);
+        hg::stable_sort(res.begin(), res.end(), [&a](index_t i, index_t j) { return a(i) < a(j); });
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_comparison_stable_arg_sort, uint8_t)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_comparison_stable_arg_sort, float)->Range(1 << min_array_size, 1 << max_array_size);
+
+template<typename value_t>
+static void BM_radix_stable_arg_sort(benchmark::State &state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        size_t size = state.range(0);
+        array_1d<value_t> a = xt::random::randint<int>({size}, 0, 256);
+        state.ResumeTiming();
+        auto res = hg::stable_arg_sort(a);
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_radix_stable_arg_sort, uint8_t)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_radix_stable_arg_sort, float)->Range(1 << min_array_size, 1 << max_array_size);
@@ -0,0 +1,121 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/accumulator/tree_accumulator.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/image/graph_image.hpp"
+#include "xtensor/xrandom.hpp"
+#include <vector>
+
+using namespace xt;
+using namespace hg;
+
+static std::size_t min_image_size = 7;
+static std::size_t max_image_size = 11;
+
+/**
+ * Parent relation of the canonical binary partition tree of a random image of size x size pixels.
+ */
+static array_1d<index_t> get_parents_random_bpt(std::size_t size) {
+    xt::random::seed(42);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+    auto res = bpt_canonical(graph, edge_weights);
+    return res.tree.parents();
+}
+
+/**
+ * Reference children storage with one vector of children per node (layout used by hg::tree before
+ * the introduction of the flat compressed sparse row layout).
+ */
+struct tree_children_vector_of_vectors {
+    std::vector<std::vector<index_t>> children;
+
+    tree_children_vector_of_vectors(const array_1d<index_t> &parents) : children(parents.size()) {
+        for (index_t v = 0; v < (index_t) parents.size() - 1; v++) {
+            children[parents(v)].push_back(v);
+        }
+    }
+};
+
+static void BM_tree_construction_csr(benchmark::State &state) {
+    auto parents = get_parents_random_bpt(state.range(0));
+    for (auto _ : state) {
+        tree t(parents);
+        benchmark::DoNotOptimize(t.num_leaves());
+    }
+}
+
+BENCHMARK(BM_tree_construction_csr)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size);
+
+static void BM_tree_construction_vector_of_vectors(benchmark::State &state) {
+    auto parents = get_parents_random_bpt(state.range(0));
+    for (auto _ : state) {
+        tree_children_vector_of_vectors t(parents);
+        benchmark::DoNotOptimize(t.children.data());
+    }
+}
+
+BENCHMARK(BM_tree_construction_vector_of_vectors)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size);
+
+static void BM_tree_children_traversal_csr(benchmark::State &state) {
+    auto parents = get_parents_random_bpt(state.range(0));
+    tree t(parents);
+    array_1d<double> input = xt::random::rand<double>({t.num_vertices()});
+    array_1d<double> output = array_1d<double>::from_shape({t.num_vertices()});
+    for (auto _ : state) {
+        for (auto i: leaves_to_root_iterator(t, leaves_it::exclude)) {
+            double sum = 0;
+            for (auto c: children_iterator(i, t)) {
+                sum += input(c);
+            }
+            output(i) = sum;
+        }
+        benchmark::DoNotOptimize(output(t.root()));
+    }
+}
+
+BENCHMARK(BM_tree_children_traversal_csr)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size);
+
+static void BM_tree_children_traversal_vector_of_vectors(benchmark::State &state) {
+    auto parents = get_parents_random_bpt(state.range(0));
+    tree_children_vector_of_vectors t(parents);
+    index_t num_leaves = (index_t) (parents.size() + 1) / 2;
+    array_1d<double> input = xt::random::rand<double>({parents.size()});
+    array_1d<double> output = array_1d<double>::from_shape({parents.size()});
+    for (auto _ : state) {
+        for (index_t i = num_leaves; i < (index_t) parents.size(); i++) {
+            double sum = 0;
+            for (auto c: t.children[i]) {
+                sum += input(c);
+            }
+            output(i) = sum;
+        }
+        benchmark::DoNotOptimize(output(parents.size() - 1));
+    }
+}
+
+BENCHMARK(BM_tree_children_traversal_vector_of_vectors)->RangeMultiplier(2)->Range(1 << min_image_size,
+                                                                                  1 << max_image_size);
+
+static void BM_tree_accumulate_sequential(benchmark::State &state) {
+    auto parents = get_parents_random_bpt(state.range(0));
+    tree t(parents);
+    array_1d<double> leaf_data = xt::random::rand<double>({t.num_leaves()});
+    for (auto _ : state) {
+        auto res = accumulate_sequential(t, leaf_data, accumulator_sum());
+        benchmark::DoNotOptimize(res.data());
+    }
+}
+
+BENCHMARK(BM_tree_accumulate_sequential)->RangeMultiplier(2)->Range(1 << min_image_size, 1 << max_image_size);
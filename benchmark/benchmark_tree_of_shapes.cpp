@@ -0,0 +1,47 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include "higra/graph.hpp"
+#include "higra/image/tree_of_shapes.hpp"
+#include "xtensor/xrandom.hpp"
+#include <limits>
+
+using namespace xt;
+using namespace hg;
+
+/*
+ * Tree of shapes of a random 4K image (3840 x 2160 pixels) with 8 bits and 16 bits integer values (hierarchical
+ * queue indexed by levels) and with floating point values (rank transform of the values).
+ */
+
+static const std::size_t image_height = 2160;
+static const std::size_t image_width = 3840;
+
+template<typename value_type>
+static void BM_tree_of_shapes_image2d(benchmark::State &state) {
+    // full range of integer types, [0, 1[ for floating point types
+    double max_value = std::is_integral<value_type>::value ? (double) std::numeric_limits<value_type>::max() : 1.;
+    xt::random::seed(42);
+    array_2d<value_type> image = xt::cast<value_type>(
+            xt::random::rand<double>({image_height, image_width}) * max_value);
+
+    for (auto _ : state) {
+        auto res = component_tree_tree_of_shapes_image2d(image);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_tree_of_shapes_image2d, uint8_t)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_tree_of_shapes_image2d, uint16_t)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_tree_of_shapes_image2d, float)->Unit(benchmark::kMillisecond);
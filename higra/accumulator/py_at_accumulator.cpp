@@ -38,6 +38,7 @@ struct def_at_accumulate {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("indices"),
               py::arg("weights"),
               py::arg("accumulator")
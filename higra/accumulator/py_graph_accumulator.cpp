@@ -40,6 +40,7 @@ struct def_accumulate_graph_edges {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("input"),
               py::arg("accumulator"));
@@ -61,6 +62,7 @@ struct def_accumulate_graph_vertices {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("input"),
               py::arg("accumulator"));
@@ -40,6 +40,7 @@ struct def_accumulate_parallel {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("input"),
               py::arg("accumulator"));
@@ -60,6 +61,7 @@ struct def_accumulate_sequential {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("leaf_data"),
               py::arg("accumulator"));
@@ -111,6 +113,7 @@ struct def_accumulate_and_combine_sequential {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("input"),
               py::arg("leaf_data"),
@@ -130,6 +133,7 @@ struct def_propagate_sequential {
                   return hg::propagate_sequential(tree, input, condition);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("input"),
               py::arg("condition"));
@@ -151,6 +155,7 @@ struct def_propagate_parallel {
                   }
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("input"),
               py::arg("condition") = pyarray<bool>{});
@@ -172,6 +177,7 @@ struct def_propagate_sequential_and_accumulate {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("vertex_data"),
               py::arg("accumulator"));
@@ -39,6 +39,7 @@ struct def_accumulate_on_contours {
                           accumulator);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("tree"),
               py::arg("vertex_data"),
@@ -35,6 +35,7 @@ struct def_project_fine_to_coarse_labelisation {
                           num_regions_coarse);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("labelisation_fine"),
               py::arg("labelisation_coarse"),
               py::arg("num_regions_fine") = 0,
@@ -51,6 +52,7 @@ struct def_from_cut {
                          return hg::make_hierarchy_aligner_from_graph_cut(g, edge_weights);
                      },
                      doc,
+                     py::call_guard<py::gil_scoped_release>(),
                      py::arg("graph"),
                      py::arg("edge_weights"));
     }
@@ -65,6 +67,7 @@ struct def_from_labelisation {
                          return hg::make_hierarchy_aligner_from_labelisation(g, vertex_labels);
                      },
                      doc,
+                     py::call_guard<py::gil_scoped_release>(),
                      py::arg("graph"),
                      py::arg("vertex_labels"));
     }
@@ -80,6 +83,7 @@ struct def_from_hierarchy {
                          return hg::make_hierarchy_aligner_from_hierarchy(g, t, altitudes);
                      },
                      doc,
+                     py::call_guard<py::gil_scoped_release>(),
                      py::arg("graph"),
                      py::arg("tree"),
                      py::arg("altitudes"));
@@ -97,6 +101,7 @@ struct def_align_hierarchy {
                   return a.align_hierarchy(t, altitudes);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"));
         c.def("align_hierarchy", [](
@@ -106,6 +111,7 @@ struct def_align_hierarchy {
                   return a.align_hierarchy(graph, saliency_map);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("saliency_map"));
         c.def("align_hierarchy", [](
@@ -116,6 +122,7 @@ struct def_align_hierarchy {
                   return a.align_hierarchy(super_vertices, t, altitudes);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("super_vertices"),
               py::arg("tree"),
               py::arg("altitudes"));
@@ -29,6 +29,7 @@ struct def_graph_cut_2_labelisation {
                   return hg::graph_cut_2_labelisation(graph, edge_weights);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights"));
     }
@@ -44,6 +45,7 @@ struct def_labelisation_2_graph_cut {
                   return hg::labelisation_2_graph_cut(graph, vertex_labels);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("vertex_labels"));
     }
@@ -56,7 +58,9 @@ struct def_minimum_spanning_tree {
     void def(pybind11::module &m, const char *doc) {
         m.def("_minimum_spanning_tree", [](const graph_t &graph,
                                            const pyarray<value_t> &edge_weights) {
+                  pybind11::gil_scoped_release release;
                   auto res = hg::minimum_spanning_tree(graph, edge_weights);
+                  pybind11::gil_scoped_acquire acquire;
                   return pybind11::make_tuple(std::move(res.mst), std::move(res.mst_edge_map));
               },
               doc,
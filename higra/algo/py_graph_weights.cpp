@@ -32,6 +32,7 @@ struct def_weight_graph {
                   return hg::weight_graph(graph, data, weight_f);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("explicit_graph"),
               py::arg("vertex_weights"),
               py::arg("weigh_function"));
@@ -28,8 +28,14 @@ struct def_make_rag {
     void def(C &c, const char *doc) {
         c.def("_make_region_adjacency_graph_from_labelisation",
               [](const graph_t &graph, const pyarray<value_t> &input) {
-                  auto res = hg::make_region_adjacency_graph_from_labelisation(graph, input);
-                  return py::make_tuple(std::move(res.rag), std::move(res.vertex_map), std::move(res.edge_map));
+                  py::gil_scoped_release release;
+                  // shared with the c++ callers through the result cache: the result is copied
+                  auto res = hg::cached_region_adjacency_graph_from_labelisation(graph, input);
+                  hg::ugraph rag = res->rag;
+                  hg::array_1d<hg::index_t> vertex_map = res->vertex_map;
+                  hg::array_1d<hg::index_t> edge_map = res->edge_map;
+                  py::gil_scoped_acquire acquire;
+                  return py::make_tuple(std::move(rag), std::move(vertex_map), std::move(edge_map));
               },
               doc,
               py::arg("graph"),
@@ -43,7 +49,9 @@ struct def_make_rag_cut {
     static
     void def(C &c, const char *doc) {
         c.def("_make_region_adjacency_graph_from_graph_cut", [](const graph_t &graph, const pyarray<value_t> &input) {
+                  py::gil_scoped_release release;
                   auto res = hg::make_region_adjacency_graph_from_graph_cut(graph, input);
+                  py::gil_scoped_acquire acquire;
                   return py::make_tuple(std::move(res.rag), std::move(res.vertex_map), std::move(res.edge_map));
               },
               doc,
@@ -61,6 +69,7 @@ struct def_rag_back_project_weights {
                   return hg::rag_back_project_weights(rag_map, rag_weights);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("rag_map"),
               py::arg("rag_weights"));
     }
@@ -30,6 +30,7 @@ struct labelisation_horizontal_cut {
                   return hg::labelisation_horizontal_cut_from_threshold(tree, altitudes, threshold);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("threshold"),
               py::arg("altitudes"));
@@ -45,6 +46,7 @@ struct labelisation_hierarchy_supervertices {
                   return hg::labelisation_hierarchy_supervertices(tree, altitudes);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"));
     }
@@ -60,6 +62,7 @@ struct binary_labelisation_from_markers {
                   return hg::binary_labelisation_from_markers(tree, object_marker, background_marker);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("object_marker"),
               py::arg("background_marker"));
@@ -72,7 +75,9 @@ struct sort_hierarchy_with_altitudes {
     void def(pybind11::module &m, const char *doc) {
         m.def("_sort_hierarchy_with_altitudes", [](const hg::tree &tree,
                                                       const pyarray<value_t> &altitudes) {
+                  pybind11::gil_scoped_release release;
                   auto res = hg::sort_hierarchy_with_altitudes(tree, altitudes);
+                  pybind11::gil_scoped_acquire acquire;
                   return pybind11::make_tuple(std::move(res.tree), std::move(res.node_map));
               },
               doc,
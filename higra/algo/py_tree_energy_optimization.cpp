@@ -56,6 +56,7 @@ struct def_labelisation_optimal_cut_from_energy {
               },
 
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("energy_attribute"),
               py::arg("accumulator"));
@@ -78,6 +79,7 @@ struct def_hierarchy_to_optimal_energy_cut_hierarchy {
                           approximation_piecewise_linear_function);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("data_fidelity_attribute"),
               py::arg("regularization_attribute"),
@@ -108,6 +110,7 @@ void py_init_tree_energy_optimization(pybind11::module &m) {
                       edge_length);
           },
           "",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("graph"),
           py::arg("vertex_perimeter"),
           py::arg("vertex_area"),
@@ -32,6 +32,7 @@ struct def_tree_monotonic_regression {
                   return hg::tree_monotonic_regression(tree, altitudes, weights, mode);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"),
               py::arg("mode"),
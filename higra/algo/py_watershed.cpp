@@ -29,6 +29,7 @@ struct def_labelisation_watershed {
                   return hg::labelisation_watershed(graph, edge_weights);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights"));
     }
@@ -47,6 +48,7 @@ struct def_labelisation_seeded_watershed {
                   return hg::labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_label);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights"),
               py::arg("vertex_seeds"),
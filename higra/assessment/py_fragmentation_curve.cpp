@@ -69,6 +69,7 @@ struct def_assesse_horizontal_cut {
                   }
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"),
               py::arg("ground_truth"),
@@ -37,6 +37,7 @@ struct def_assess_partition {
                   }
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("candidate"),
               py::arg("ground_truth"),
               py::arg("partition_measure"));
@@ -36,6 +36,7 @@ struct def_contour_length_component_tree {
                   );
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("graph"),
               py::arg("vertex_perimeter"),
@@ -56,6 +57,7 @@ struct def_attribute_extrema {
                   );
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"));
     }
@@ -76,6 +78,7 @@ struct def_attribute_height {
                   );
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"),
               py::arg("increasing_altitudes"));
@@ -99,6 +102,7 @@ struct def_attribute_extinction_value {
                   );
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("altitudes"),
               py::arg("attribute"),
@@ -119,6 +123,7 @@ struct def_attribute_children_pair_sum_product {
                   );
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("tree"),
               py::arg("node_weights"));
     }
@@ -131,6 +136,7 @@ void py_init_attributes(pybind11::module &m) {
               return hg::attribute_sibling(tree, skip);
           },
           "",
+          pybind11::call_guard<pybind11::gil_scoped_release>(),
           pybind11::arg("tree"),
           pybind11::arg("skip") = 1);
 
@@ -139,6 +145,7 @@ void py_init_attributes(pybind11::module &m) {
               return hg::attribute_depth(tree);
           },
           "",
+          pybind11::call_guard<pybind11::gil_scoped_release>(),
           pybind11::arg("tree"));
 
     m.def("_attribute_child_number",
@@ -146,6 +153,7 @@ void py_init_attributes(pybind11::module &m) {
               return hg::attribute_child_number(tree);
           },
           "",
+          pybind11::call_guard<pybind11::gil_scoped_release>(),
           pybind11::arg("tree"));
 
     add_type_overloads<def_contour_length_component_tree,
@@ -305,6 +305,8 @@ def set_auto_cache_state(boolean):
 
     If set to ``False``, auto-cached functions will behave as normal function: they won't try to cache results.
 
+    This also activates or deactivates the result cache of the C++ library (see :func:`~higra.get_result_cache_statistics`).
+
     :See:
 
     :func:`~higra.get_auto_cache_state`: get current state of the automatic caching.
@@ -315,6 +317,7 @@ def set_auto_cache_state(boolean):
     if not isinstance(boolean, type(True)):
         raise TypeError("Parameter must be a bool.")
     hg.__auto_caching = boolean
+    hg.cpp._set_result_cache_state(boolean)
 
 
 def get_auto_cache_state():
@@ -330,6 +333,59 @@ def get_auto_cache_state():
     return hg.__auto_caching
 
 
+def get_result_cache_statistics():
+    """
+    Statistics of the result cache of the C++ library.
+
+    Some results that are expensive to compute and used by several algorithms (lowest common ancestor preprocessing,
+    area of a tree, region adjacency graph...) are stored by the C++ library in a process wide cache: they are reused
+    as long as the object they depend on (tree or graph) is alive and not modified.
+
+    :See:
+
+    :func:`~higra.set_result_cache_memory_limit`: bound the memory used by the cache.
+
+    :func:`~higra.clear_auto_cache`: clear the cache.
+
+    :func:`~higra.set_auto_cache_state`: activate or deactivate the cache.
+
+    :return: a dictionary with the keys ``hits``, ``misses``, ``evictions``, ``num_entries`` and ``memory_usage`` (in bytes)
+    """
+    return hg.cpp._get_result_cache_statistics()
+
+
+def reset_result_cache_statistics():
+    """
+    Reset the ``hits``, ``misses`` and ``evictions`` counters of the result cache of the C++ library
+    (see :func:`~higra.get_result_cache_statistics`).
+
+    :return: nothing
+    """
+    hg.cpp._reset_result_cache_statistics()
+
+
+def set_result_cache_memory_limit(memory_limit):
+    """
+    Set the maximal memory used by the result cache of the C++ library (see :func:`~higra.get_result_cache_statistics`).
+    The least recently used results are evicted when the limit is exceeded. A limit equal to 0 disables the cache.
+
+    The default limit is 1GiB.
+
+    :param memory_limit: memory limit in bytes
+    :return: nothing
+    """
+    hg.cpp._set_result_cache_memory_limit(memory_limit)
+
+
+def get_result_cache_memory_limit():
+    """
+    Maximal memory used by the result cache of the C++ library (see :func:`~higra.set_result_cache_memory_limit`).
+
+    :return: memory limit in bytes
+    """
+    return hg.cpp._get_result_cache_memory_limit()
+
+
 # keyword used to store auto cached results in reference object data cache
 _auto_cache_keyword = "data_auto_cache"
 
@@ -338,6 +394,9 @@ def clear_auto_cache(*, function=None, reference_object=None, data_cache=None):
     """
     Cleanup the result cache for the specified elements
 
+    If no function is specified, the results stored by the C++ library for the reference object (or for all objects if
+    no reference object is specified) are also cleared (see :func:`~higra.get_result_cache_statistics`).
+
     :param function: function or name of a :func:`~higra.auto_cache` decorated function to clear (if ``None`` all functions
         are cleared)
     :param reference_object: reference object whose cached data have to be cleared (if ``None`` cache data
@@ -359,6 +418,12 @@ def clear_auto_cache(*, function=None, reference_object=None, data_cache=None):
             else:
                 raise TypeError("Cannot determine name of " + str(function))
 
+    if function_name is None:
+        if reference_object is None:
+            hg.cpp._clear_result_cache()
+        elif isinstance(reference_object, (hg.Tree, hg.UndirectedGraph)):
+            hg.cpp._invalidate_result_cache(reference_object)
+
     if function_name is None and reference_object is None:
         for obj, cache in data_cache:
             if _auto_cache_keyword in cache:
@@ -24,7 +24,7 @@ void py_init_log(pybind11::module &m) {
           "Define if function call tracing is enabled.",
           pybind11::arg("enabled"));
 
-    m.def("get_trace", []() { return hg::logger::trace_enabled(); },
+    m.def("get_trace", []() { return hg::logger::trace_enabled().load(); },
           "Get the state of function call tracing.");
 
     /*m.def("add_logger_callback",
@@ -37,7 +37,10 @@ void py_init_log(pybind11::module &m) {
 
     m.def("logger_register_print_callback",
           []() {
+              std::lock_guard<std::mutex> lock(hg::logger::callbacks_mutex());
               hg::logger::callbacks().push_back([](const std::string &msg) {
+                  // messages may be emitted from a thread that does not hold the GIL
+                  pybind11::gil_scoped_acquire acquire;
                   pybind11::object buildins = pybind11::module::import("builtins");
                   pybind11::object print = buildins.attr("print");
                   print(msg);
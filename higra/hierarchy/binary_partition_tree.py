@@ -12,7 +12,7 @@ import higra as hg
 import numpy as np
 
 
-def binary_partition_tree_complete_linkage(graph, edge_weights):
+def binary_partition_tree_complete_linkage(graph, edge_weights, algorithm=hg.BptLinkageAlgorithm.heap):
     """
     Binary partition tree with complete linkage distance.
 
@@ -25,12 +25,18 @@ def binary_partition_tree_complete_linkage(graph, edge_weights):
 
     Regions are then iteratively merged following the above distance (closest first) until a single region remains
 
+    Complete linkage is reducible: the tree can also be computed by merging all the pairs of reciprocal nearest
+    neighbours in successive rounds (``hg.BptLinkageAlgorithm.reciprocal_nearest_neighbours``), nearest neighbours
+    being searched in parallel if Higra is built with TBB. The result is the same as with the default
+    algorithm (``hg.BptLinkageAlgorithm.heap``) up to ties.
+
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
+    :param algorithm: algorithm used to compute the tree (see :class:`~higra.BptLinkageAlgorithm`)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
-    res = hg.cpp._binary_partition_tree_complete_linkage(graph, edge_weights)
+    res = hg.cpp._binary_partition_tree_complete_linkage(graph, edge_weights, algorithm)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -39,7 +45,8 @@ def binary_partition_tree_complete_linkage(graph, edge_weights):
     return tree, altitudes
 
 
-def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights=None):
+def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights=None,
+                                          algorithm=hg.BptLinkageAlgorithm.heap):
     """
     Binary partition tree with average linkage distance.
 
@@ -52,9 +59,15 @@ def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weigh
 
     with :math:`Z = \sum_{x \in X, y \in Y, \{x,y\} \in E} w_2({x,y})`.
 
+    Average linkage is reducible: the tree can also be computed by merging all the pairs of reciprocal nearest
+    neighbours in successive rounds (``hg.BptLinkageAlgorithm.reciprocal_nearest_neighbours``), nearest neighbours
+    being searched in parallel if Higra is built with TBB. The result is the same as with the default
+    algorithm (``hg.BptLinkageAlgorithm.heap``) up to ties and rounding errors.
+
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
     :param edge_weight_weights: weighting of edge weights of the input graph (default to an array of ones)
+    :param algorithm: algorithm used to compute the tree (see :class:`~higra.BptLinkageAlgorithm`)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
@@ -63,7 +76,7 @@ def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weigh
     else:
         edge_weights, edge_weight_weights = hg.cast_to_common_type(edge_weights, edge_weight_weights)
 
-    res = hg.cpp._binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights)
+    res = hg.cpp._binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, algorithm)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -220,7 +233,7 @@ def binary_partition_tree(graph, weight_function, edge_weights):
 
     .. code-block:: python
 
-        def weight_function(graph,              # the current state of the graph
+        def weight_function(graph,              # the input graph
                        fusion_edge_index,       # the edge between the two vertices being merged
                        new_region,              # the new vertex in the graph
                        merged_region1,          # the first vertex merged
@@ -12,7 +12,7 @@ import higra as hg
 import numpy as np
 
 
-def component_tree_min_tree(graph, vertex_weights):
+def component_tree_min_tree(graph, vertex_weights, algorithm=hg.ComponentTreeAlgorithm.automatic):
     """
     Min Tree hierarchy from the input vertex weighted graph.
 
@@ -28,13 +28,19 @@ def component_tree_min_tree(graph, vertex_weights):
     Component Tree Computation with Application to Pattern Recognition in Astronomical Imaging," \
     IEEE ICIP 2007.
 
+    The tree can be computed either with the sequential algorithm of [3]_ (``hg.ComponentTreeAlgorithm.sequential``)
+    or with a parallel algorithm (``hg.ComponentTreeAlgorithm.parallel``), which is only multi-threaded if Higra is built
+    with TBB. By default (``hg.ComponentTreeAlgorithm.automatic``), the parallel algorithm is used on large graphs when
+    TBB is available. All algorithms give exactly the same result.
+
     :param graph: input graph
     :param vertex_weights: vertex weights of the input graph
+    :param algorithm: algorithm used to compute the tree (see :class:`~higra.ComponentTreeAlgorithm`)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
     vertex_weights = hg.linearize_vertex_weights(vertex_weights, graph)
 
-    res = hg.cpp._component_tree_min_tree(graph, vertex_weights)
+    res = hg.cpp._component_tree_min_tree(graph, vertex_weights, algorithm)
     tree = res.tree()
     altitudes = res.altitudes()
 
@@ -43,7 +49,7 @@ def component_tree_min_tree(graph, vertex_weights):
     return tree, altitudes
 
 
-def component_tree_max_tree(graph, vertex_weights):
+def component_tree_max_tree(graph, vertex_weights, algorithm=hg.ComponentTreeAlgorithm.automatic):
     """
     Max Tree hierarchy from the input vertex weighted graph.
 
@@ -51,13 +57,19 @@ def component_tree_max_tree(graph, vertex_weights):
     The algorithm used in this
     implementation was first described in [3]_.
 
+    The tree can be computed either with the sequential algorithm of [3]_ (``hg.ComponentTreeAlgorithm.sequential``)
+    or with a parallel algorithm (``hg.ComponentTreeAlgorithm.parallel``), which is only multi-threaded if Higra is built
+    with TBB. By default (``hg.ComponentTreeAlgorithm.automatic``), the parallel algorithm is used on large graphs when
+    TBB is available. All algorithms give exactly the same result.
+
     :param graph: input graph
     :param vertex_weights: vertex weights of the input graph
+    :param algorithm: algorithm used to compute the tree (see :class:`~higra.ComponentTreeAlgorithm`)
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
     vertex_weights = hg.linearize_vertex_weights(vertex_weights, graph)
 
-    res = hg.cpp._component_tree_max_tree(graph, vertex_weights)
+    res = hg.cpp._component_tree_max_tree(graph, vertex_weights, algorithm)
     tree = res.tree()
     altitudes = res.altitudes()
 
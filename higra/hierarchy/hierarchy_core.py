@@ -12,16 +12,22 @@ import higra as hg
 import numpy as np
 
 
-def bpt_canonical(graph, edge_weights):
+def bpt_canonical(graph, edge_weights, algorithm=hg.BptAlgorithm.automatic):
     """
     Computes the canonical binary partition tree (binary tree by altitude ordering) of the given weighted graph.
     This is also known as single/min linkage clustering.
 
+    The tree can be computed either with a sequential Kruskal algorithm (``hg.BptAlgorithm.kruskal``) or with a
+    parallel Boruvka algorithm (``hg.BptAlgorithm.boruvka``), which is only multi-threaded if Higra is built with TBB.
+    By default (``hg.BptAlgorithm.automatic``), Boruvka is used on large graphs when TBB is available.
+    All algorithms give exactly the same result.
+
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
+    :param algorithm: algorithm used to compute the tree (see :class:`~higra.BptAlgorithm`)
     :return: a tree (Concept :class:`~higra.CptBinaryHierarchy`) and its node altitudes
     """
-    res = hg.cpp._bpt_canonical(graph, edge_weights)
+    res = hg.cpp._bpt_canonical(graph, edge_weights, algorithm)
     tree = res.tree()
     altitudes = res.altitudes()
     mst = res.mst()
@@ -47,13 +47,18 @@ struct def_binary_partition_tree_average_linkage {
     static
     void def(pybind11::module &m, const char *doc) {
         m.def("_binary_partition_tree_average_linkage",
-              [](const hg::ugraph &graph, pyarray<T> &edge_weights, pyarray<T> &edge_weight_weights) {
-                  return binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+              [](const hg::ugraph &graph,
+                 pyarray<T> &edge_weights,
+                 pyarray<T> &edge_weight_weights,
+                 hg::bpt_linkage_algorithm algorithm) {
+                  return binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, algorithm);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights"),
-              py::arg("edge_weight_weights"));
+              py::arg("edge_weight_weights"),
+              py::arg("algorithm") = hg::bpt_linkage_algorithm::heap);
     }
 };
 
@@ -66,6 +71,7 @@ struct def_binary_partition_tree_exponential_linkage {
                   return binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_weight_weights);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights"),
               py::arg("alpha"),
@@ -85,6 +91,7 @@ struct def_binary_partition_tree_ward_linkage {
                   return binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("vertex_centroids"),
               py::arg("vertex_sizes"),
@@ -102,7 +109,7 @@ struct def_binary_partition_tree_custom_linkage {
                  py::object weighting_function) {
                   //using new_neighbours_type = const std::vector<binary_partition_tree_internal::new_neighbour<T> >;
                   auto weighter = [&weighting_function](
-                          const undirected_graph<hg::undirected_graph_internal::hash_setS> &g,
+                          const hg::ugraph &g,
                           index_t fusion_edge_index,
                           index_t new_region,
                           index_t merged_region1,
@@ -127,18 +134,26 @@ struct def_binary_partition_tree_complete_linkage {
     static
     void def(pybind11::module &m, const char *doc) {
         m.def("_binary_partition_tree_complete_linkage",
-              [](const hg::ugraph &graph, pyarray<T> &edge_weights) {
-                  return hg::binary_partition_tree_complete_linkage(graph, edge_weights);
+              [](const hg::ugraph &graph, pyarray<T> &edge_weights, hg::bpt_linkage_algorithm algorithm) {
+                  return hg::binary_partition_tree_complete_linkage(graph, edge_weights, algorithm);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
-              py::arg("edge_weights"));
+              py::arg("edge_weights"),
+              py::arg("algorithm") = hg::bpt_linkage_algorithm::heap);
     }
 };
 
 void py_init_binary_partition_tree(pybind11::module &m) {
     xt::import_numpy();
 
+    py::enum_<hg::bpt_linkage_algorithm>(m, "BptLinkageAlgorithm",
+                                         "Algorithm used to compute a binary partition tree with a reducible linkage "
+                                         "(both algorithms give the same result up to ties).")
+            .value("heap", hg::bpt_linkage_algorithm::heap)
+            .value("reciprocal_nearest_neighbours", hg::bpt_linkage_algorithm::reciprocal_nearest_neighbours);
+
     add_type_overloads<def_binary_partition_tree_ward_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
     add_type_overloads<def_binary_partition_tree_average_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
     add_type_overloads<def_binary_partition_tree_complete_linkage, HG_TEMPLATE_FLOAT_TYPES>(m, "");
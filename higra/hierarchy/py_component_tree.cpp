@@ -26,12 +26,15 @@ struct def_min_tree {
     void def(C &c, const char *doc) {
         c.def("_component_tree_min_tree",
               [](const graph_t &graph,
-                 const pyarray<value_t> &vertex_weights) {
-                  return hg::component_tree_min_tree(graph, vertex_weights);
+                 const pyarray<value_t> &vertex_weights,
+                 hg::component_tree_algorithm algorithm) {
+                  return hg::component_tree_min_tree(graph, vertex_weights, algorithm);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
-              py::arg("vertex_weights"));
+              py::arg("vertex_weights"),
+              py::arg("algorithm") = hg::component_tree_algorithm::automatic);
     }
 };
 
@@ -42,18 +45,27 @@ struct def_max_tree {
     void def(C &c, const char *doc) {
         c.def("_component_tree_max_tree",
               [](const graph_t &graph,
-                 const pyarray<value_t> &vertex_weights) {
-                  return hg::component_tree_max_tree(graph, vertex_weights);
+                 const pyarray<value_t> &vertex_weights,
+                 hg::component_tree_algorithm algorithm) {
+                  return hg::component_tree_max_tree(graph, vertex_weights, algorithm);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
-              py::arg("vertex_weights"));
+              py::arg("vertex_weights"),
+              py::arg("algorithm") = hg::component_tree_algorithm::automatic);
     }
 };
 
 
 void py_init_component_tree(pybind11::module &m) {
     xt::import_numpy();
+    py::enum_<hg::component_tree_algorithm>(m, "ComponentTreeAlgorithm",
+                                            "Algorithm used to compute the min tree and the max tree "
+                                            "(all algorithms give the same result).")
+            .value("automatic", hg::component_tree_algorithm::automatic)
+            .value("sequential", hg::component_tree_algorithm::sequential)
+            .value("parallel", hg::component_tree_algorithm::parallel);
 
     add_type_overloads<def_min_tree<hg::ugraph>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
     add_type_overloads<def_min_tree<hg::regular_grid_graph_1d >, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
@@ -45,12 +45,16 @@ struct def_bptCanonical {
     template<typename value_t, typename C>
     static
     void def(C &m, const char *doc) {
-        m.def("_bpt_canonical", [](const graph_t &graph, const pyarray<value_t> &edge_weights) {
-                  return hg::bpt_canonical(graph, edge_weights);
+        m.def("_bpt_canonical", [](const graph_t &graph,
+                                   const pyarray<value_t> &edge_weights,
+                                   hg::bpt_algorithm algorithm) {
+                  return hg::bpt_canonical(graph, edge_weights, algorithm);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
-              py::arg("edge_weights")
+              py::arg("edge_weights"),
+              py::arg("algorithm") = hg::bpt_algorithm::automatic
         );
     }
 };
@@ -64,6 +68,7 @@ struct def_quasi_flat_zone_hierarchy {
                   return hg::quasi_flat_zone_hierarchy(graph, edge_weights);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights")
         );
@@ -85,6 +90,13 @@ void add_simplified_tree(M &m) {
 
 void py_init_hierarchy_core(pybind11::module &m) {
     xt::import_numpy();
+    py::enum_<hg::bpt_algorithm>(m, "BptAlgorithm",
+                                 "Algorithm used to compute the canonical binary partition tree "
+                                 "(all algorithms give the same result).")
+            .value("automatic", hg::bpt_algorithm::automatic)
+            .value("kruskal", hg::bpt_algorithm::kruskal)
+            .value("boruvka", hg::bpt_algorithm::boruvka);
+
     add_type_overloads<def_node_weighted_tree_and_mst<hg::tree>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
     add_type_overloads<def_bptCanonical<hg::ugraph>, HG_TEMPLATE_SNUMERIC_TYPES>
             (m,
@@ -97,6 +109,7 @@ void py_init_hierarchy_core(pybind11::module &m) {
               return hg::simplify_tree(t, criterion, process_leaves);
           },
           "",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("tree"),
           py::arg("deleted_nodes"),
           py::arg("process_leaves"));
@@ -111,6 +124,7 @@ void py_init_hierarchy_core(pybind11::module &m) {
               return hg::tree_2_binary_tree(t);
           },
           "",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("tree")
     );
 }
\ No newline at end of file
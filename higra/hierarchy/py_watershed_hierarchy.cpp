@@ -30,7 +30,15 @@ struct def_watershed_hierarchy_by_attribute {
                       // FIXME can we do better for return type ?
                  const std::function<pyarray<double>(const hg::tree &,
                                                      const hg::array_1d<value_t> &)> &attribute_functor) {
-                  return hg::watershed_hierarchy_by_attribute(graph, edge_weights, attribute_functor);
+                  // the GIL is only held while the Python attribute functor is running
+                  py::gil_scoped_release release;
+                  return hg::watershed_hierarchy_by_attribute(
+                          graph, edge_weights,
+                          [&attribute_functor](const hg::tree &tree, const hg::array_1d<value_t> &altitudes) {
+                              py::gil_scoped_acquire acquire;
+                              // copy the result so that no Python object outlives the GIL
+                              return hg::array_1d<double>(attribute_functor(tree, altitudes));
+                          });
               },
               doc,
               py::arg("graph"),
@@ -53,6 +61,7 @@ struct def_watershed_hierarchy_by_minima_ordering {
                                                                     minima_altitudes);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("graph"),
               py::arg("edge_weights"),
               py::arg("minima_ranks"),
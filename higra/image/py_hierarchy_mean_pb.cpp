@@ -30,10 +30,12 @@ struct def_oriented_watershed {
                                        const std::vector<size_t> &shape,
                                        const pyarray<value_t> &edge_weights,
                                        const pyarray<value_t> &edge_orientations) {
+                  py::gil_scoped_release release;
                   auto res = hg::oriented_watershed(graph,
                                                    hg::embedding_grid_2d(shape),
                                                    edge_weights,
                                                    edge_orientations);
+                  py::gil_scoped_acquire acquire;
                   return py::make_tuple(std::move(res.first.rag),
                                         std::move(res.first.vertex_map),
                                         std::move(res.first.edge_map),
@@ -57,10 +59,12 @@ struct def_hierarchy_mean_pb {
                                        const std::vector<size_t> &shape,
                                        const pyarray<value_t> &edge_weights,
                                        const pyarray<value_t> &edge_orientations) {
+                  py::gil_scoped_release release;
                   auto res = hg::mean_pb_hierarchy(graph,
                                                    hg::embedding_grid_2d(shape),
                                                    edge_weights,
                                                    edge_orientations);
+                  py::gil_scoped_acquire acquire;
                   return py::make_tuple(std::move(res.first.rag),
                                         std::move(res.first.vertex_map),
                                         std::move(res.first.edge_map),
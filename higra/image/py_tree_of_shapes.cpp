@@ -45,6 +45,7 @@ struct def_tree_of_shapes {
                                                                    exterior_vertex);
               },
               doc,
+              py::call_guard<py::gil_scoped_release>(),
               py::arg("image"),
               py::arg("padding") = "mean",
               py::arg("original_size") = true,
@@ -10,6 +10,7 @@
 
 #include "py_tree_io.hpp"
 #include "higra/io/tree_io.hpp"
+#include "higra/io/tree_binary_io.hpp"
 #include "../py_common.hpp"
 #include "xtensor-python/pyarray.hpp"
 #include "xtensor-python/pytensor.hpp"
@@ -18,6 +19,33 @@
 template<typename T>
 using pyarray = xt::pyarray<T>;
 
+namespace py = pybind11;
+
+template<typename T>
+bool try_add_binary_attribute(hg::tree_binary_io_internal::tree_binary_saver_helper &saver,
+                              const std::string &name,
+                              const py::array &array) {
+    if (!py::isinstance<py::array_t<T>>(array)) {
+        return false;
+    }
+    auto c_array = py::array_t<T, py::array::c_style>::ensure(array);
+    hg_assert(c_array.ndim() == 1, "Only scalar attributes are supported.");
+    std::array<std::size_t, 1> shape{(std::size_t) c_array.size()};
+    saver.add_attribute(name, xt::adapt(c_array.data(), shape[0], xt::no_ownership(), shape));
+    return true;
+}
+
+template<typename T>
+py::array binary_attribute_view(const hg::mapped_tree_file &file, const std::string &name, const py::object &base) {
+    py::array res(py::dtype::of<T>(),
+                  {(py::ssize_t) file.num_vertices()},
+                  {(py::ssize_t) sizeof(T)},
+                  static_cast<const T *>(file.attribute_data(name)),
+                  base);
+    res.attr("setflags")(py::arg("write") = false);
+    return res;
+}
+
 void py_init_tree_io(pybind11::module &m) {
     xt::import_numpy();
 
@@ -42,5 +70,78 @@ void py_init_tree_io(pybind11::module &m) {
           pybind11::arg("filename"),
           pybind11::arg("tree"),
           pybind11::arg("attributes") = std::map<std::string, pyarray<double>>());
-}
 
+    m.def("_read_tree_binary", [](const std::string &filename) {
+              auto file = new hg::mapped_tree_file(filename);
+              // the capsule owns the mapping, it is released when the last attribute view is garbage collected
+              py::capsule base(file, [](void *p) { delete static_cast<hg::mapped_tree_file *>(p); });
+              py::dict attributes;
+              for (const auto &name: file->attribute_names()) {
+                  py::array a;
+                  switch (file->attribute_dtype(name)) {
+                      case hg::tree_binary_dtype::int8:
+                          a = binary_attribute_view<int8_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::uint8:
+                          a = binary_attribute_view<uint8_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::int16:
+                          a = binary_attribute_view<int16_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::uint16:
+                          a = binary_attribute_view<uint16_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::int32:
+                          a = binary_attribute_view<int32_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::uint32:
+                          a = binary_attribute_view<uint32_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::int64:
+                          a = binary_attribute_view<int64_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::uint64:
+                          a = binary_attribute_view<uint64_t>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::float32:
+                          a = binary_attribute_view<float>(*file, name, base);
+                          break;
+                      case hg::tree_binary_dtype::float64:
+                          a = binary_attribute_view<double>(*file, name, base);
+                          break;
+                  }
+                  attributes[py::str(name)] = a;
+              }
+              return py::make_tuple(file->get_tree(), attributes);
+          },
+          "Memory map a tree stored in binary format. Return a pair with the tree and a map of attributes "
+          "(tree, dict[string => read only 1d array])",
+          pybind11::arg("filename"));
+
+    m.def("save_tree_binary", [](const std::string &filename, const hg::tree &tree,
+                                 const std::map<std::string, py::array> &attributes) {
+              std::ofstream file(filename, std::ios::binary);
+              hg_assert(file.good(), "Cannot open file '" + filename + "'.");
+              auto s = hg::save_tree_binary(file, tree);
+              for (const auto &e: attributes) {
+                  bool ok = try_add_binary_attribute<int8_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<uint8_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<int16_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<uint16_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<int32_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<uint32_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<int64_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<uint64_t>(s, e.first, e.second) ||
+                            try_add_binary_attribute<float>(s, e.first, e.second) ||
+                            try_add_binary_attribute<double>(s, e.first, e.second);
+                  hg_assert(ok, "Unsupported element type for attribute '" + e.first + "'.");
+              }
+              s.finalize();
+          },
+          "Save a tree and scalar attributes to a binary format that can be memory mapped (see read_tree_binary). "
+          "Attributes must be numpy 1d arrays of numerical type (integral or floating point) stored in a dictionary "
+          "with string keys (attribute names): their values are stored without type conversion.",
+          pybind11::arg("filename"),
+          pybind11::arg("tree"),
+          pybind11::arg("attributes") = std::map<std::string, py::array>());
+}
@@ -29,6 +29,28 @@ def read_tree(filename):
     return tree, attribute_map
 
 
+def read_tree_binary(filename):
+    """
+    Read a tree stored in binary format (see :func:`~higra.save_tree_binary`).
+
+    The file is memory mapped: attributes are returned as read only numpy arrays that directly reference the file
+    content, their type is the one of the saved arrays. Attribute values are thus loaded lazily by the operating
+    system and can be shared by several processes opening the same file. The mapping is closed when all the
+    attribute arrays have been garbage collected.
+
+    Attributes are also registered as tree object attributes.
+
+    :param filename: path to the tree file
+    :return: a pair (tree, attribute_map)
+    """
+    tree, attribute_map = hg.cpp._read_tree_binary(filename)
+
+    for k in attribute_map:
+        hg.set_attribute(tree, k, attribute_map[k])
+
+    return tree, attribute_map
+
+
 def print_partition_tree(tree, *,
                altitudes=None,
                attribute=None,
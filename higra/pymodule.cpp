@@ -11,6 +11,7 @@
 #include "pybind11/pybind11.h"
 
 #include "all.hpp"
+#include "higra/utils.hpp"
 
 #include "xtl/xmeta_utils.hpp"
 
@@ -34,6 +35,8 @@ PYBIND11_MODULE(higram, m) {
     m.attr("__version__") = "dev";
 #endif
     xt::import_numpy();
+    // numpy dtype used to represent indices (see HG_USE_32BIT_INDEX)
+    m.attr("index_t") = pybind11::dtype::of<hg::index_t>();
     py_init_accumulators(m);
     py_init_algo_graph_core(m);
     py_init_algo_tree(m);
@@ -58,6 +61,7 @@ PYBIND11_MODULE(higram, m) {
     py_init_pink_io(m);
     py_init_rag(m);
     py_init_regular_graph(m);
+    py_init_result_cache(m);
     py_init_scipy(m);
     py_init_tree_accumulator(m);
     py_init_tree_contour_accumulator(m);
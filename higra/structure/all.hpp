@@ -13,5 +13,6 @@
 #include "py_embedding.hpp"
 #include "py_lca_fast.hpp"
 #include "py_regular_graph.hpp"
+#include "py_result_cache.hpp"
 #include "py_tree_graph.hpp"
 #include "py_undirected_graph.hpp"
@@ -37,6 +37,7 @@ struct def_lca_vertices {
                   return l.lca(vertices1, vertices2);
               },
               doc,
+              pybind11::call_guard<pybind11::gil_scoped_release>(),
               pybind11::arg("vertices1"),
               pybind11::arg("vertices2"));
     }
@@ -44,15 +45,17 @@ struct def_lca_vertices {
 
 void py_init_lca_fast(pybind11::module &m) {
     xt::import_numpy();
-    auto c = py::class_<lca_fast>(m, "LCAFast",
+    // shared holder: the preprocessing of a tree may be stored in the result cache (see cached_lca_fast)
+    auto c = py::class_<lca_fast, std::shared_ptr<lca_fast>>(m, "LCAFast",
                                   "Provides fast :math:`\\mathcal{O}(1)` lowest common ancestor computation in a tree thanks "
-                                  "to a linearithmic preprocessing of the tree.",
+                                  "to a linear preprocessing of the tree.",
                                   py::dynamic_attr());
 
     c.def(py::init<tree>(),
           "Preprocess the given tree in order for fast lowest common ancestor (LCA) computation.\n\n"
           "Consider using the function :func:`~higra.Tree.lowest_ancestor_preprocess` instead of calling this constructor to"
           "avoid preprocessing the same tree several times.",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("tree"));
 
     c.def("lca",
@@ -69,6 +72,7 @@ void py_init_lca_fast(pybind11::module &m) {
     c.def("lca",
           [](const lca_fast &l, const ugraph &g) { return l.lca(edge_iterator(g)); },
           "Compute the LCA of every edge of the given graph.",
+          py::call_guard<py::gil_scoped_release>(),
           py::arg("UndirectedGraph"));
 
     add_type_overloads<def_lca_vertices, int, unsigned int, long long, unsigned long long>
@@ -81,27 +85,27 @@ void py_init_lca_fast(pybind11::module &m) {
               auto state = l.get_state();
               return py::make_tuple(
                       state.m_num_vertices,
-                      std::move(state.m_Euler),
-                      std::move(state.m_Depth),
-                      std::move(state.m_Represent),
-                      std::move(state.m_Number),
-                      std::move(state.m_Minim),
-                      state.m_rep);
+                      std::move(state.m_preorder),
+                      std::move(state.m_nodes),
+                      std::move(state.m_values),
+                      std::move(state.m_prefix_min),
+                      std::move(state.m_suffix_min),
+                      std::move(state.m_sparse_table));
           },
           "Return an opaque structure representing the internal state of the object");
 
 
     c.def_static("_make_from_state",
                  [](size_t &a0,
-                    const pyarray<index_t> &a1,
-                    const pyarray<index_t> &a2,
-                    const pyarray<index_t> &a3,
-                    const pyarray<index_t> &a4,
-                    const pyarray<index_t> &a5,
-                    size_t &a6) {
+                    const pyarray<lca_fast::value_type> &a1,
+                    const pyarray<lca_fast::value_type> &a2,
+                    const pyarray<lca_fast::value_type> &a3,
+                    const pyarray<lca_fast::value_type> &a4,
+                    const pyarray<lca_fast::value_type> &a5,
+                    const pyarray<lca_fast::value_type> &a6) {
 
                      return hg::lca_fast::make_lca_fast(
-                             lca_fast::internal_state<pyarray<index_t>, pyarray<index_t>>(
+                             lca_fast::internal_state<pyarray<lca_fast::value_type>, pyarray<lca_fast::value_type>>(
                                      a0, a1, a2, a3, a4, a5, a6));
 
                  },
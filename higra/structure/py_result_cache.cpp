@@ -0,0 +1,58 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "py_result_cache.hpp"
+#include "../py_common.hpp"
+#include "higra/graph.hpp"
+#include "higra/structure/result_cache.hpp"
+
+namespace py = pybind11;
+using namespace hg;
+
+void py_init_result_cache(pybind11::module &m) {
+
+    m.def("_get_result_cache_statistics", []() {
+              auto &cache = result_cache::global();
+              py::dict res;
+              res["hits"] = cache.hits();
+              res["misses"] = cache.misses();
+              res["evictions"] = cache.evictions();
+              res["num_entries"] = cache.num_entries();
+              res["memory_usage"] = cache.memory_usage();
+              return res;
+          },
+          "Statistics of the global result cache.");
+
+    m.def("_reset_result_cache_statistics", []() { result_cache::global().reset_statistics(); },
+          "Reset the statistics of the global result cache.");
+
+    m.def("_clear_result_cache", []() { result_cache::global().clear(); },
+          "Remove all the results stored in the global result cache.");
+
+    m.def("_set_result_cache_memory_limit",
+          [](std::size_t memory_limit) { result_cache::global().set_memory_limit(memory_limit); },
+          "Set the maximal memory (in bytes) used by the global result cache.",
+          py::arg("memory_limit"));
+
+    m.def("_get_result_cache_memory_limit", []() { return result_cache::global().memory_limit(); },
+          "Get the maximal memory (in bytes) used by the global result cache.");
+
+    m.def("_set_result_cache_state", [](bool enabled) { result_cache::global().set_enabled(enabled); },
+          "Activates or deactivates the global result cache.",
+          py::arg("enabled"));
+
+    m.def("_invalidate_result_cache", [](const tree &t) { result_cache::global().invalidate(t); },
+          "Remove all the results associated to the given tree from the global result cache.",
+          py::arg("tree"));
+
+    m.def("_invalidate_result_cache", [](const ugraph &g) { result_cache::global().invalidate(g); },
+          "Remove all the results associated to the given graph from the global result cache.",
+          py::arg("graph"));
+}
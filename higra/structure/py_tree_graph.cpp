@@ -10,6 +10,7 @@
 
 #include "py_tree_graph.hpp"
 #include "py_common_graph.hpp"
+#include "higra/structure/lca_fast.hpp"
 
 namespace py = pybind11;
 
@@ -191,6 +192,12 @@ void py_init_tree_graph(pybind11::module &m) {
             (c,
              "Get largest vertex which contains the given vertex and whose altitude is stricly less than the given altitude lambda.");
 
+    c.def("_lowest_common_ancestor_preprocess", [](const graph_t &tree) {
+              return std::const_pointer_cast<hg::lca_fast>(hg::cached_lca_fast(tree));
+          },
+          "Lowest common ancestor preprocessing of the tree stored in the global result cache.",
+          py::call_guard<py::gil_scoped_release>());
+
     c.def("_lowest_common_ancestor", [](const graph_t &tree, hg::index_t vertex1, hg::index_t vertex2) {
               hg_assert_vertex_index(tree, vertex1);
               hg_assert_vertex_index(tree, vertex2);
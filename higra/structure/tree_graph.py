@@ -97,13 +97,14 @@ def __lowest_common_ancestor_preprocess(self):
 
     :Complexity:
 
-    The preprocessing runs in linearithmic time  :math:`\\mathcal{O}(n\log(n))` with :math:`n` the number of vertices in the tree.
+    The preprocessing runs in linear time  :math:`\\mathcal{O}(n)` with :math:`n` the number of vertices in the tree.
+    The preprocessing is shared with the C++ algorithms through the result cache (see :func:`~higra.get_result_cache_statistics`).
 
     :return: An object of type :class:`~higra.LCAFast`
     """
     lca_fast = hg.get_attribute(self, "lca_fast")
     if lca_fast is None:
-        lca_fast = hg.LCAFast(self)
+        lca_fast = self._lowest_common_ancestor_preprocess()
         hg.set_attribute(self, "lca_fast", lca_fast)
     return lca_fast
 
@@ -34,23 +34,42 @@ namespace hg {
 
     namespace accumulator_detail {
 
+        /**
+         * Reducers of the marginal accumulators: the reducer type is a template parameter of the accumulator such
+         * that calls to the reducer can be inlined (and vectorized on vectorial data).
+         */
+        template<typename value_type>
+        struct reducer_min {
+            value_type operator()(const value_type &v1, const value_type &v2) const {
+                return (v2 < v1) ? v2 : v1;
+            }
+        };
+
+        template<typename value_type>
+        struct reducer_max {
+            value_type operator()(const value_type &v1, const value_type &v2) const {
+                return (v1 < v2) ? v2 : v1;
+            }
+        };
+
         /**
         * Marginal processing accumulator
         * @tparam S the storage type
+        * @tparam reducer_t binary function type used to reduce values
         * @tparam vectorial bool: is dimension of storage > 0 (different from scalar)
         */
-        template<typename S, bool vectorial>
+        template<typename S, typename reducer_t, bool vectorial>
         struct acc_marginal_impl {
         };
 
-        template<typename S>
-        struct acc_marginal_impl<S, true> {
+        template<typename S, typename reducer_t>
+        struct acc_marginal_impl<S, reducer_t, true> {
 
             static const bool is_vectorial = true;
 
-            using self_type = acc_marginal_impl<S, is_vectorial>;
+            using self_type = acc_marginal_impl<S, reducer_t, is_vectorial>;
             using value_type = typename std::iterator_traits<S>::value_type;
-            using reducer_type = std::function<value_type(value_type, value_type)>;
+            using reducer_type = reducer_t;
 
 
             acc_marginal_impl(const S &storage_begin, const S &storage_end, const reducer_type &reducer,
@@ -70,9 +89,12 @@ namespace hg {
             template<typename T, typename ...Args>
             void
             accumulate(T value_begin, Args &&...) {
+                // indexed loop on a local copy of the reducer: helps the compiler to vectorize
+                const auto size = m_storage_end - m_storage_begin;
+                const auto reducer = m_reducer;
                 auto s = m_storage_begin;
-                for (; s != m_storage_end; s++, value_begin++) {
-                    *s = m_reducer(*value_begin, *s);
+                for (std::ptrdiff_t i = 0; i < size; i++) {
+                    s[i] = reducer(value_begin[i], s[i]);
                 }
             };
 
@@ -99,14 +121,14 @@ namespace hg {
             S m_storage_end;
         };
 
-        template<typename S>
-        struct acc_marginal_impl<S, false> {
+        template<typename S, typename reducer_t>
+        struct acc_marginal_impl<S, reducer_t, false> {
 
             static const bool is_vectorial = false;
 
-            using self_type = acc_marginal_impl<S, is_vectorial>;
+            using self_type = acc_marginal_impl<S, reducer_t, is_vectorial>;
             using value_type = typename std::iterator_traits<S>::value_type;
-            using reducer_type = std::function<value_type(value_type, value_type)>;
+            using reducer_type = reducer_t;
 
             acc_marginal_impl(const S &storage_begin, const S &, const reducer_type &reducer,
                               const value_type &init_value) :
@@ -169,12 +191,14 @@ namespace hg {
             template<typename T = self_type, typename ...Args>
             typename std::enable_if_t<T::is_vectorial>
             initialize(Args &&...) {
+                m_counter = 0;
                 std::fill(m_storage_begin, m_storage_end, 0);
             }
 
             template<typename T = self_type, typename ...Args>
             typename std::enable_if_t<!T::is_vectorial>
             initialize(Args &&...) {
+                m_counter = 0;
                 *m_storage_begin = 0;
             }
 
@@ -561,10 +585,11 @@ namespace hg {
         auto make_accumulator(S &storage) const {
             using value_type = typename S::value_type;
             using iterator_type = decltype(storage.begin());
-            return accumulator_detail::acc_marginal_impl<iterator_type, vectorial>(
+            using reducer_type = std::plus<value_type>;
+            return accumulator_detail::acc_marginal_impl<iterator_type, reducer_type, vectorial>(
                     storage.begin(),
                     storage.end(),
-                    std::plus<value_type>(),
+                    reducer_type(),
                     0);
         }
 
@@ -581,10 +606,11 @@ namespace hg {
         auto make_accumulator(S &storage) const {
             using value_type = typename S::value_type;
             using iterator_type = decltype(storage.begin());
-            return accumulator_detail::acc_marginal_impl<iterator_type, vectorial>(
+            using reducer_type = accumulator_detail::reducer_min<value_type>;
+            return accumulator_detail::acc_marginal_impl<iterator_type, reducer_type, vectorial>(
                     storage.begin(),
                     storage.end(),
-                    [](value_type v1, value_type v2) { return (std::min)(v1, v2); },
+                    reducer_type(),
                     (std::numeric_limits<value_type>::max)());
         }
 
@@ -601,10 +627,11 @@ namespace hg {
         auto make_accumulator(S &storage) const {
             using value_type = typename S::value_type;
             using iterator_type = decltype(storage.begin());
-            return accumulator_detail::acc_marginal_impl<iterator_type, vectorial>(
+            using reducer_type = accumulator_detail::reducer_max<value_type>;
+            return accumulator_detail::acc_marginal_impl<iterator_type, reducer_type, vectorial>(
                     storage.begin(),
                     storage.end(),
-                    [](value_type v1, value_type v2) { return (std::max)(v1, v2); },
+                    reducer_type(),
                     std::numeric_limits<value_type>::lowest());
         }
 
@@ -621,10 +648,11 @@ namespace hg {
         auto make_accumulator(S &storage) const {
             using value_type = typename S::value_type;
             using iterator_type = decltype(storage.begin());
-            return accumulator_detail::acc_marginal_impl<iterator_type, vectorial>(
+            using reducer_type = std::multiplies<value_type>;
+            return accumulator_detail::acc_marginal_impl<iterator_type, reducer_type, vectorial>(
                     storage.begin(),
                     storage.end(),
-                    std::multiplies<value_type>(),
+                    reducer_type(),
                     1);
         }
 
@@ -13,11 +13,190 @@
 #include "../graph.hpp"
 #include "accumulator.hpp"
 #include "../structure/details/light_axis_view.hpp"
+#include <numeric>
+#include <vector>
 
 namespace hg {
 
+    /**
+     * Execution mode of the tree accumulators and tree propagators.
+     *
+     * - sequential: nodes are processed one at a time in topological order;
+     * - multithreaded: nodes are grouped by levels (height for bottom-up algorithms, depth for top-down algorithms) and
+     *   the nodes of a level are processed in parallel, with a synchronization barrier between two consecutive levels;
+     * - automatic: multithreaded if Higra is compiled with TBB support, several threads are available and the tree is
+     *   large enough (for the algorithms processing nodes level by level, the data associated to each node must also
+     *   be large enough to amortize the cost of grouping nodes by levels), sequential otherwise.
+     *
+     * The computations performed for each node are the same in both modes (in particular, the children of a node are
+     * always accumulated in the same order): the multithreaded mode thus gives exactly the same results as the
+     * sequential mode.
+     */
+    enum class tree_accumulator_execution {
+        automatic,
+        sequential,
+        multithreaded
+    };
+
     namespace tree_accumulator_detail {
 
+        /**
+         * Minimal number of nodes of a tree for the automatic execution mode to use multithreading.
+         */
+        const index_t multithreaded_threshold = 1 << 17;
+
+        /**
+         * Number of nodes processed by a task in multithreaded mode.
+         */
+        const index_t multithreaded_block_size = 1 << 11;
+
+        /**
+         * Minimal number of values associated to each node for the automatic execution mode to use multithreading in
+         * algorithms processing nodes level by level: on scalar data, grouping nodes by levels costs about as much as
+         * the sequential algorithm itself.
+         */
+        const index_t multithreaded_level_min_values = 16;
+
+        /**
+         * Decides if an algorithm must be executed in multithreaded mode.
+         *
+         * @param level_synchronous true if the algorithm processes nodes level by level
+         * @param values_per_node number of values associated to each node of the tree
+         */
+        template<typename tree_t>
+        bool use_multithreading(const tree_t &tree,
+                                tree_accumulator_execution execution,
+                                bool level_synchronous,
+                                index_t values_per_node) {
+            switch (execution) {
+                case tree_accumulator_execution::sequential:
+                    return false;
+                case tree_accumulator_execution::multithreaded:
+                    return true;
+                default:
+#ifdef HG_USE_TBB
+                    return (index_t) num_vertices(tree) >= multithreaded_threshold &&
+                           tbb::this_task_arena::max_concurrency() > 1 &&
+                           (!level_synchronous || values_per_node >= multithreaded_level_min_values);
+#else
+                    (void) tree;
+                    (void) level_synchronous;
+                    (void) values_per_node;
+                    return false;
+#endif
+            }
+        }
+
+        /**
+         * A contiguous range of node indices stored in an array.
+         */
+        struct node_range {
+            const index_t *m_begin;
+            const index_t *m_end;
+
+            const index_t *begin() const {
+                return m_begin;
+            }
+
+            const index_t *end() const {
+                return m_end;
+            }
+        };
+
+        /**
+         * Nodes grouped by levels: the nodes of the level l are nodes[offsets[l]], ..., nodes[offsets[l + 1] - 1].
+         */
+        struct tree_levels {
+            std::vector<index_t> offsets;
+            std::vector<index_t> nodes;
+        };
+
+        /**
+         * Group the nodes in the range [first, last) by increasing level (counting sort).
+         * In a given level, nodes are sorted by increasing index.
+         */
+        inline
+        tree_levels group_nodes_by_level(const std::vector<index_t> &level, index_t first, index_t last) {
+            tree_levels levels;
+            index_t max_level = 0;
+            for (index_t i = first; i < last; i++) {
+                max_level = (std::max)(max_level, level[i]);
+            }
+            levels.offsets.assign(max_level + 2, 0);
+            for (index_t i = first; i < last; i++) {
+                levels.offsets[level[i] + 1]++;
+            }
+            std::partial_sum(levels.offsets.begin(), levels.offsets.end(), levels.offsets.begin());
+            std::vector<index_t> position(levels.offsets.begin(), levels.offsets.end() - 1);
+            levels.nodes.resize(last - first);
+            for (index_t i = first; i < last; i++) {
+                levels.nodes[position[level[i]]++] = i;
+            }
+            return levels;
+        }
+
+        /**
+         * Non leaf nodes grouped by height: the children of a node of height h have a height strictly smaller than h.
+         */
+        template<typename tree_t>
+        tree_levels non_leaf_nodes_by_height(const tree_t &tree) {
+            std::vector<index_t> height(num_vertices(tree), 0);
+            for (auto i: leaves_to_root_iterator(tree, leaves_it::include, root_it::exclude)) {
+                auto p = parent(i, tree);
+                height[p] = (std::max)(height[p], height[i] + 1);
+            }
+            return group_nodes_by_level(height, num_leaves(tree), num_vertices(tree));
+        }
+
+        /**
+         * Non root nodes grouped by depth: the parent of a node of depth d has depth d - 1.
+         */
+        template<typename tree_t>
+        tree_levels non_root_nodes_by_depth(const tree_t &tree) {
+            std::vector<index_t> depth(num_vertices(tree));
+            depth[root(tree)] = 0;
+            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
+                depth[i] = depth[parent(i, tree)] + 1;
+            }
+            return group_nodes_by_level(depth, 0, root(tree));
+        }
+
+        /**
+         * Apply the given function to blocks of nodes of each level: levels are processed one after the other and
+         * the blocks of a level are processed in parallel.
+         */
+        template<typename range_fun_t>
+        void for_each_level_block(const tree_levels &levels, range_fun_t &fun) {
+            const index_t *nodes = levels.nodes.data();
+            for (index_t l = 0; l < (index_t) levels.offsets.size() - 1; l++) {
+                index_t level_begin = levels.offsets[l];
+                index_t level_end = levels.offsets[l + 1];
+                index_t num_blocks = (level_end - level_begin + multithreaded_block_size - 1) / multithreaded_block_size;
+                if (num_blocks <= 1) {
+                    fun(node_range{nodes + level_begin, nodes + level_end});
+                } else {
+                    parfor(0, num_blocks, [&fun, nodes, level_begin, level_end](index_t b) {
+                        index_t block_begin = level_begin + b * multithreaded_block_size;
+                        index_t block_end = (std::min)(block_begin + multithreaded_block_size, level_end);
+                        fun(node_range{nodes + block_begin, nodes + block_end});
+                    });
+                }
+            }
+        }
+
+        /**
+         * Apply the given function to blocks of nodes in the range [first, last): blocks are processed in parallel.
+         */
+        template<typename range_fun_t>
+        void for_each_block(index_t first, index_t last, range_fun_t &fun) {
+            index_t num_blocks = (last - first + multithreaded_block_size - 1) / multithreaded_block_size;
+            parfor(0, num_blocks, [&fun, first, last](index_t b) {
+                index_t block_begin = first + b * multithreaded_block_size;
+                index_t block_end = (std::min)(block_begin + multithreaded_block_size, last);
+                fun(irange<index_t>(block_begin, block_end));
+            });
+        }
+
 
         template<bool vectorial,
                 typename tree_t,
@@ -26,7 +205,8 @@ namespace hg {
                 typename output_t = typename T::value_type>
         auto accumulate_parallel_impl(const tree_t &tree,
                                       const xt::xexpression<T> &xinput,
-                                      const accumulator_t accumulator) {
+                                      const accumulator_t accumulator,
+                                      tree_accumulator_execution execution) {
             HG_TRACE();
             auto &input = xinput.derived_cast();
             hg_assert_node_weights(tree, input);
@@ -37,26 +217,28 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
-
-            for (auto i: leaves_iterator(tree)) {
-                output_view.set_position(i);
-                acc.set_storage(output_view);
-                acc.initialize();
-                acc.finalize();
-            }
-
-            for (auto i : leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                output_view.set_position(i);
-                acc.set_storage(output_view);
-                acc.initialize();
-                for (auto c : children_iterator(i, tree)) {
-                    input_view.set_position(c);
-                    acc.accumulate(input_view.begin());
+            // leaves have no children: they are processed as the other nodes
+            auto process = [&tree, &input, &output, &accumulator](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+
+                for (auto i : nodes) {
+                    output_view.set_position(i);
+                    acc.set_storage(output_view);
+                    acc.initialize();
+                    for (auto c : children_iterator(i, tree)) {
+                        input_view.set_position(c);
+                        acc.accumulate(input_view.begin());
+                    }
+                    acc.finalize();
                 }
-                acc.finalize();
+            };
+
+            if (use_multithreading(tree, execution, false, output.size() / num_vertices(tree))) {
+                for_each_block(0, num_vertices(tree), process);
+            } else {
+                process(leaves_to_root_iterator(tree));
             }
 
             return output;
@@ -69,7 +251,8 @@ namespace hg {
                 typename output_t = typename T::value_type>
         auto accumulate_sequential_impl(const tree_t &tree,
                                         const xt::xexpression<T> &xvertex_data,
-                                        const accumulator_t &accumulator) {
+                                        const accumulator_t &accumulator,
+                                        tree_accumulator_execution execution) {
             HG_TRACE();
             auto &vertex_data = xvertex_data.derived_cast();
             hg_assert_leaf_weights(tree, vertex_data);
@@ -80,26 +263,38 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
-            auto input_view = make_light_axis_view<vectorial>(output);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
-
-            for (auto i: leaves_iterator(tree)) {
-                output_view.set_position(i);
-                vertex_data_view.set_position(i);
-                output_view = vertex_data_view;
-            }
-
-            for (auto i : leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                output_view.set_position(i);
-                acc.set_storage(output_view);
-                acc.initialize();
-                for (auto c : children_iterator(i, tree)) {
-                    input_view.set_position(c);
-                    acc.accumulate(input_view.begin());
+            auto process_leaves = [&vertex_data, &output](const auto &nodes) {
+                auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                for (auto i: nodes) {
+                    output_view.set_position(i);
+                    vertex_data_view.set_position(i);
+                    output_view = vertex_data_view;
                 }
-                acc.finalize();
+            };
+
+            auto process_non_leaves = [&tree, &output, &accumulator](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(output);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+                for (auto i : nodes) {
+                    output_view.set_position(i);
+                    acc.set_storage(output_view);
+                    acc.initialize();
+                    for (auto c : children_iterator(i, tree)) {
+                        input_view.set_position(c);
+                        acc.accumulate(input_view.begin());
+                    }
+                    acc.finalize();
+                }
+            };
+
+            if (use_multithreading(tree, execution, true, output.size() / num_vertices(tree))) {
+                for_each_block(0, num_leaves(tree), process_leaves);
+                for_each_level_block(non_leaf_nodes_by_height(tree), process_non_leaves);
+            } else {
+                process_leaves(leaves_iterator(tree));
+                process_non_leaves(leaves_to_root_iterator(tree, leaves_it::exclude));
             }
             return output;
         };
@@ -115,7 +310,8 @@ namespace hg {
                                                     const xt::xexpression<T1> &xinput,
                                                     const xt::xexpression<T2> &xvertex_data,
                                                     accumulator_t &accumulator,
-                                                    combination_fun_t combine) {
+                                                    combination_fun_t combine,
+                                                    tree_accumulator_execution execution) {
             HG_TRACE();
             auto &input = xinput.derived_cast();
             hg_assert_node_weights(tree, input);
@@ -137,31 +333,42 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto inout_view = make_light_axis_view<vectorial>(output);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
-
-            auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
-
-            for (auto i: leaves_iterator(tree)) {
-                output_view.set_position(i);
-                vertex_data_view.set_position(i);
-                output_view = vertex_data_view;
-            }
-
-            for (auto i : leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                output_view.set_position(i);
-                acc.set_storage(output_view);
-                acc.initialize();
-                for (auto c : children_iterator(i, tree)) {
-
-                    inout_view.set_position(c);
-                    acc.accumulate(inout_view.begin());
+            auto process_leaves = [&vertex_data, &output](const auto &nodes) {
+                auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                for (auto i: nodes) {
+                    output_view.set_position(i);
+                    vertex_data_view.set_position(i);
+                    output_view = vertex_data_view;
                 }
-                acc.finalize();
-                input_view.set_position(i);
-                output_view.combine(input_view, combine);
+            };
+
+            auto process_non_leaves = [&tree, &input, &output, &accumulator, &combine](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto inout_view = make_light_axis_view<vectorial>(output);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+                for (auto i : nodes) {
+                    output_view.set_position(i);
+                    acc.set_storage(output_view);
+                    acc.initialize();
+                    for (auto c : children_iterator(i, tree)) {
+
+                        inout_view.set_position(c);
+                        acc.accumulate(inout_view.begin());
+                    }
+                    acc.finalize();
+                    input_view.set_position(i);
+                    output_view.combine(input_view, combine);
+                }
+            };
+
+            if (use_multithreading(tree, execution, true, output.size() / num_vertices(tree))) {
+                for_each_block(0, num_leaves(tree), process_leaves);
+                for_each_level_block(non_leaf_nodes_by_height(tree), process_non_leaves);
+            } else {
+                process_leaves(leaves_iterator(tree));
+                process_non_leaves(leaves_to_root_iterator(tree, leaves_it::exclude));
             }
 
             return output;
@@ -172,22 +379,31 @@ namespace hg {
                 typename T1,
                 typename output_t = typename T1::value_type>
         auto propagate_parallel_impl(const tree_t &tree,
-                                     const xt::xexpression<T1> &xinput) {
+                                     const xt::xexpression<T1> &xinput,
+                                     tree_accumulator_execution execution) {
             HG_TRACE();
             auto &input = xinput.derived_cast();
             hg_assert_node_weights(tree, input);
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(input.shape());
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
+            auto process = [&tree, &input, &output](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
 
-            auto aparents = parents(tree).storage_begin();
+                auto aparents = parents(tree).storage_begin();
 
-            for (auto i: root_to_leaves_iterator(tree)) {
-                input_view.set_position(aparents[i]);
-                output_view.set_position(i);
-                output_view = input_view;
+                for (auto i: nodes) {
+                    input_view.set_position(aparents[i]);
+                    output_view.set_position(i);
+                    output_view = input_view;
+                }
+            };
+
+            if (use_multithreading(tree, execution, false, output.size() / num_vertices(tree))) {
+                for_each_block(0, num_vertices(tree), process);
+            } else {
+                process(root_to_leaves_iterator(tree));
             }
             return output;
         };
@@ -199,7 +415,8 @@ namespace hg {
                 typename output_t = typename T1::value_type>
         auto propagate_parallel_impl(const tree_t &tree,
                                      const xt::xexpression<T1> &xinput,
-                                     const xt::xexpression<T2> &xcondition) {
+                                     const xt::xexpression<T2> &xcondition,
+                                     tree_accumulator_execution execution) {
             HG_TRACE();
             auto &input = xinput.derived_cast();
             auto &condition = xcondition.derived_cast();
@@ -208,19 +425,27 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(input.shape());
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
+            auto process = [&tree, &input, &condition, &output](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
 
-            auto aparents = parents(tree).storage_begin();
+                auto aparents = parents(tree).storage_begin();
 
-            for (auto i: root_to_leaves_iterator(tree)) {
-                if (condition(i)) {
-                    input_view.set_position(aparents[i]);
-                } else {
-                    input_view.set_position(i);
+                for (auto i: nodes) {
+                    if (condition(i)) {
+                        input_view.set_position(aparents[i]);
+                    } else {
+                        input_view.set_position(i);
+                    }
+                    output_view.set_position(i);
+                    output_view = input_view;
                 }
-                output_view.set_position(i);
-                output_view = input_view;
+            };
+
+            if (use_multithreading(tree, execution, false, output.size() / num_vertices(tree))) {
+                for_each_block(0, num_vertices(tree), process);
+            } else {
+                process(root_to_leaves_iterator(tree));
             }
             return output;
         };
@@ -232,7 +457,8 @@ namespace hg {
                 typename output_t = typename T1::value_type>
         auto propagate_sequential_impl(const tree_t &tree,
                                        const xt::xexpression<T1> &xinput,
-                                       const xt::xexpression<T2> &xcondition) {
+                                       const xt::xexpression<T2> &xcondition,
+                                       tree_accumulator_execution execution) {
             HG_TRACE();
             auto &input = xinput.derived_cast();
             auto &condition = xcondition.derived_cast();
@@ -241,27 +467,39 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(input.shape());
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto inout_view = make_light_axis_view<vectorial>(output);
+            {
+                // root cannot be deleted
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                output_view.set_position(root(tree));
+                input_view.set_position(root(tree));
+                output_view = input_view;
+            }
 
-            auto aparents = parents(tree).storage_begin();
+            auto process = [&tree, &input, &condition, &output](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto inout_view = make_light_axis_view<vectorial>(output);
 
-            // root cannot be deleted
-            output_view.set_position(root(tree));
-            input_view.set_position(root(tree));
-            output_view = input_view;
+                auto aparents = parents(tree).storage_begin();
+
+                for (auto i: nodes) {
+                    output_view.set_position(i);
+                    if (condition(i)) {
+                        inout_view.set_position(aparents[i]);
+                        output_view = inout_view;
+                    } else {
+                        input_view.set_position(i);
+                        output_view = input_view;
+                    }
 
-            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-                output_view.set_position(i);
-                if (condition(i)) {
-                    inout_view.set_position(aparents[i]);
-                    output_view = inout_view;
-                } else {
-                    input_view.set_position(i);
-                    output_view = input_view;
                 }
+            };
 
+            if (use_multithreading(tree, execution, true, output.size() / num_vertices(tree))) {
+                for_each_level_block(non_root_nodes_by_depth(tree), process);
+            } else {
+                process(root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude));
             }
             return output;
         };
@@ -273,7 +511,8 @@ namespace hg {
                 typename output_t = typename T::value_type>
         auto propagate_sequential_and_accumulate_impl(const tree_t &tree,
                                                       const xt::xexpression<T> &xinput,
-                                                      accumulator_t &accumulator) {
+                                                      accumulator_t &accumulator,
+                                                      tree_accumulator_execution execution) {
             HG_TRACE();
             auto &input = xinput.derived_cast();
             hg_assert_node_weights(tree, input);
@@ -288,32 +527,46 @@ namespace hg {
             output_shape.insert(output_shape.begin(), num_vertices(tree));
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto parent_view = make_light_axis_view<vectorial>(output);
-
-            auto aparents = parents(tree).storage_begin();
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
-            // root cannot be deleted
-            output_view.set_position(root(tree));
-            input_view.set_position(root(tree));
-            acc.set_storage(output_view);
-            acc.initialize();
-            acc.accumulate(input_view.begin());
-            acc.finalize();
-
-            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-                output_view.set_position(i);
+            {
+                // root cannot be deleted
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+                output_view.set_position(root(tree));
+                input_view.set_position(root(tree));
                 acc.set_storage(output_view);
                 acc.initialize();
+                acc.accumulate(input_view.begin());
+                acc.finalize();
+            }
 
-                parent_view.set_position(aparents[i]);
-                acc.accumulate(parent_view.begin());
+            auto process = [&tree, &input, &output, &accumulator](const auto &nodes) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto parent_view = make_light_axis_view<vectorial>(output);
 
-                input_view.set_position(i);
-                acc.accumulate(input_view.begin());
+                auto aparents = parents(tree).storage_begin();
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
 
-                acc.finalize();
+                for (auto i: nodes) {
+                    output_view.set_position(i);
+                    acc.set_storage(output_view);
+                    acc.initialize();
+
+                    parent_view.set_position(aparents[i]);
+                    acc.accumulate(parent_view.begin());
+
+                    input_view.set_position(i);
+                    acc.accumulate(input_view.begin());
+
+                    acc.finalize();
+                }
+            };
+
+            if (use_multithreading(tree, execution, true, output.size() / num_vertices(tree))) {
+                for_each_level_block(non_root_nodes_by_depth(tree), process);
+            } else {
+                process(root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude));
             }
 
             return output;
@@ -324,12 +577,13 @@ namespace hg {
     template<typename tree_t, typename T, typename accumulator_t, typename output_t = typename T::value_type>
     auto accumulate_parallel(const tree_t &tree,
                              const xt::xexpression<T> &xinput,
-                             const accumulator_t &accumulator) {
+                             const accumulator_t &accumulator,
+                             tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &input = xinput.derived_cast();
         if (input.dimension() == 1) {
-            return tree_accumulator_detail::accumulate_parallel_impl<false>(tree, xinput, accumulator);
+            return tree_accumulator_detail::accumulate_parallel_impl<false>(tree, xinput, accumulator, execution);
         } else {
-            return tree_accumulator_detail::accumulate_parallel_impl<true>(tree, xinput, accumulator);
+            return tree_accumulator_detail::accumulate_parallel_impl<true>(tree, xinput, accumulator, execution);
         }
     };
 
@@ -337,13 +591,14 @@ namespace hg {
     template<typename tree_t, typename T, typename accumulator_t, typename output_t = typename T::value_type>
     auto accumulate_sequential(const tree_t &tree,
                                const xt::xexpression<T> &xvertex_data,
-                               const accumulator_t &accumulator) {
+                               const accumulator_t &accumulator,
+                               tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &vertex_data = xvertex_data.derived_cast();
 
         if (vertex_data.dimension() == 1) {
-            return tree_accumulator_detail::accumulate_sequential_impl<false>(tree, xvertex_data, accumulator);
+            return tree_accumulator_detail::accumulate_sequential_impl<false>(tree, xvertex_data, accumulator, execution);
         } else {
-            return tree_accumulator_detail::accumulate_sequential_impl<true>(tree, xvertex_data, accumulator);
+            return tree_accumulator_detail::accumulate_sequential_impl<true>(tree, xvertex_data, accumulator, execution);
         }
     };
 
@@ -352,66 +607,71 @@ namespace hg {
                                            const xt::xexpression<T1> &xinput,
                                            const xt::xexpression<T2> &xvertex_data,
                                            const accumulator_t &accumulator,
-                                           const combination_fun_t &combine) {
+                                           const combination_fun_t &combine,
+                                           tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
             return tree_accumulator_detail::accumulate_and_combine_sequential_impl<false>(tree, xinput, xvertex_data,
-                                                                                          accumulator, combine);
+                                                                                          accumulator, combine, execution);
         } else {
             return tree_accumulator_detail::accumulate_and_combine_sequential_impl<true>(tree, xinput, xvertex_data,
-                                                                                         accumulator, combine);
+                                                                                         accumulator, combine, execution);
         }
     };
 
     template<typename tree_t, typename T1>
     auto propagate_parallel(const tree_t &tree,
-                            const xt::xexpression<T1> &xinput) {
+                            const xt::xexpression<T1> &xinput,
+                            tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
-            return tree_accumulator_detail::propagate_parallel_impl<false>(tree, xinput);
+            return tree_accumulator_detail::propagate_parallel_impl<false>(tree, xinput, execution);
         } else {
-            return tree_accumulator_detail::propagate_parallel_impl<true>(tree, xinput);
+            return tree_accumulator_detail::propagate_parallel_impl<true>(tree, xinput, execution);
         }
     };
 
     template<typename tree_t, typename T1, typename T2>
     auto propagate_parallel(const tree_t &tree,
                             const xt::xexpression<T1> &xinput,
-                            const xt::xexpression<T2> &xcondition) {
+                            const xt::xexpression<T2> &xcondition,
+                            tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
-            return tree_accumulator_detail::propagate_parallel_impl<false>(tree, xinput, xcondition);
+            return tree_accumulator_detail::propagate_parallel_impl<false>(tree, xinput, xcondition, execution);
         } else {
-            return tree_accumulator_detail::propagate_parallel_impl<true>(tree, xinput, xcondition);
+            return tree_accumulator_detail::propagate_parallel_impl<true>(tree, xinput, xcondition, execution);
         }
     };
 
     template<typename tree_t, typename T1, typename T2>
     auto propagate_sequential(const tree_t &tree,
                               const xt::xexpression<T1> &xinput,
-                              const xt::xexpression<T2> &xcondition) {
+                              const xt::xexpression<T2> &xcondition,
+                              tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
-            return tree_accumulator_detail::propagate_sequential_impl<false>(tree, xinput, xcondition);
+            return tree_accumulator_detail::propagate_sequential_impl<false>(tree, xinput, xcondition, execution);
         } else {
-            return tree_accumulator_detail::propagate_sequential_impl<true>(tree, xinput, xcondition);
+            return tree_accumulator_detail::propagate_sequential_impl<true>(tree, xinput, xcondition, execution);
         }
     };
 
     template<typename tree_t, typename T, typename accumulator_t>
     auto propagate_sequential_and_accumulate(const tree_t &tree,
                               const xt::xexpression<T> &xinput,
-                              const accumulator_t &accumulator) {
+                              const accumulator_t &accumulator,
+                              tree_accumulator_execution execution = tree_accumulator_execution::automatic) {
         auto &input = xinput.derived_cast();
 
         if (input.dimension() == 1) {
-            return tree_accumulator_detail::propagate_sequential_and_accumulate_impl<false>(tree, xinput, accumulator);
+            return tree_accumulator_detail::propagate_sequential_and_accumulate_impl<false>(tree, xinput, accumulator, execution);
         } else {
-            return tree_accumulator_detail::propagate_sequential_and_accumulate_impl<true>(tree, xinput, accumulator);
+            return tree_accumulator_detail::propagate_sequential_and_accumulate_impl<true>(tree, xinput, accumulator, execution);
         }
     };
 
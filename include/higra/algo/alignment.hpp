@@ -13,6 +13,7 @@
 #include "rag.hpp"
 #include "tree.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
+#include "../structure/sparse_intersection_table.hpp"
 #include "xtensor/xsort.hpp"
 
 namespace hg {
@@ -28,6 +29,13 @@ namespace hg {
    *
    * If num_regions_fine or num_regions_coarse are not provided, they will
    * be determined as max(xlabelisation_fine) + 1 and max(xlabelisation_coarse) + 1
+   *
+   * If several coarse regions have the same largest intersection with a fine region, the one with the smallest
+   * label is chosen. A fine region with no element is associated to the coarse region 0.
+   *
+   * The intersections are computed in a sparse intersection table: the memory used is linear with respect to
+   * the number of elements and to the number of regions of both labelisations.
+   *
    * @tparam T1
    * @tparam T2
    * @param xlabelisation_fine
@@ -61,14 +69,22 @@ namespace hg {
             num_regions_coarse = xt::amax(labelisation_coarse)(0) + 1;
         }
 
-        array_2d<size_t> intersections = xt::zeros<size_t>({num_regions_fine, num_regions_coarse});
-
-        for (index_t i = 0; i < (index_t)labelisation_fine.size(); i++) {
-            intersections(labelisation_fine(i), labelisation_coarse(i))++;
+        auto intersections = make_sparse_intersection_table(labelisation_fine,
+                                                            labelisation_coarse,
+                                                            (index_t) num_regions_fine,
+                                                            (index_t) num_regions_coarse);
+
+        // entries of a row are sorted by increasing column: the first maximum has the smallest label
+        array_1d<index_t> res = xt::zeros<index_t>({num_regions_fine});
+        for (index_t i = 0; i < (index_t) num_regions_fine; i++) {
+            index_t max_value = 0;
+            for (index_t k = intersections.row_begin(i); k < intersections.row_begin(i + 1); k++) {
+                if (intersections.values(k) > max_value) {
+                    max_value = intersections.values(k);
+                    res(i) = intersections.columns(k);
+                }
+            }
         }
-
-        // cast size_t -> index_t
-        array_1d<index_t> res = xt::argmax(intersections, 1);
         return res;
     }
 
@@ -181,7 +197,7 @@ namespace hg {
                       "Cannot align given hierarchy: incompatible sizes!");
             auto coarse_rag = make_region_adjacency_graph_from_graph_cut(graph, saliency_map);
             auto coarse_rag_edge_weights = rag_accumulate(coarse_rag.edge_map, saliency_map, accumulator_first());
-            auto bpt_coarse_rag = bpt_canonical(coarse_rag.rag, coarse_rag_edge_weights);
+            auto bpt_coarse_rag = bpt_canonical_edge_list(coarse_rag.rag, coarse_rag_edge_weights);
 
             auto coarse_sm_on_fine_rag =
                     alignment_internal::project_hierarchy(m_fine_rag,
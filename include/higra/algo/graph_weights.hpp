@@ -56,6 +56,39 @@ namespace hg {
         return result;
     };
 
+    /**
+     * Compute edge-weights of a grid graph based on a weighting function.
+     *
+     * Edges are enumerated row by row: their extremities are obtained without any edge index to edge conversion.
+     *
+     * @tparam result_value_t
+     * @param graph
+     * @param fun
+     * @return an array of weights
+     */
+    template<typename result_value_t=double>
+    auto weight_graph(const grid_graph_2d &graph, const std::function<result_value_t(
+            typename grid_graph_2d::vertex_descriptor,
+            typename grid_graph_2d::vertex_descriptor)> &fun) {
+        auto result = array_1d<result_value_t>::from_shape({num_edges(graph)});
+        const index_t width = graph.width();
+        const index_t num_forward = graph.forward_neighbours().size();
+        const auto &shifts = graph.forward_shifts();
+
+        parfor(0, graph.height(), [&](index_t y) {
+            index_t ei = graph.row_start(y);
+            index_t v = y * width;
+            for (index_t x = 0; x < width; x++, v++) {
+                for (index_t j = 0; j < num_forward; j++) {
+                    if (graph.is_valid_forward_neighbour(y, x, j)) {
+                        result(ei++) = fun(v, v + shifts[j]);
+                    }
+                }
+            }
+        });
+        return result;
+    };
+
     /**
      * Compute edge-weights of a graph based from the vertex-weights and a predefined weighting function (see weight_functions enum).
      *
@@ -118,6 +118,54 @@ namespace hg {
         return region_adjacency_graph{std::move(rag), std::move(vertex_map), std::move(edge_map)};
     }
 
+    namespace rag_internal {
+
+        /**
+         * Region adjacency graph stored in the result cache with the labelisation used to compute it
+         */
+        struct cached_region_adjacency_graph {
+            array_1d<index_t> vertex_labels;
+            region_adjacency_graph rag;
+
+            std::size_t memory_size() const {
+                return (vertex_labels.size() + rag.vertex_map.size() + rag.edge_map.size()) * sizeof(index_t) +
+                       num_vertices(rag.rag) * sizeof(std::vector<index_t>) +
+                       num_edges(rag.rag) * (sizeof(ugraph::edge_descriptor) + 2 * sizeof(index_t));
+            }
+        };
+    }
+
+    /**
+     * Region adjacency graph of a vertex labeled graph (see make_region_adjacency_graph_from_labelisation) stored
+     * in the global result cache: the result is reused as long as the graph is not modified and the same
+     * labelisation is given. Only the rag of the last labelisation is stored for a given graph.
+     *
+     * @tparam T
+     * @param graph
+     * @param xvertex_labels
+     * @return a shared pointer on a constant region_adjacency_graph
+     */
+    template<typename T>
+    auto cached_region_adjacency_graph_from_labelisation(const ugraph &graph,
+                                                         const xt::xexpression<T> &xvertex_labels) {
+        auto &vertex_labels = xvertex_labels.derived_cast();
+        hg_assert_vertex_weights(graph, vertex_labels);
+        hg_assert_1d_array(vertex_labels);
+        hg_assert_integral_value_type(vertex_labels);
+
+        auto cached = result_cache::global().get_or_compute<rag_internal::cached_region_adjacency_graph>(
+                graph, "region_adjacency_graph",
+                [&graph, &vertex_labels]() {
+                    return rag_internal::cached_region_adjacency_graph{
+                            vertex_labels,
+                            make_region_adjacency_graph_from_labelisation(graph, vertex_labels)};
+                },
+                [&vertex_labels](const rag_internal::cached_region_adjacency_graph &entry) {
+                    return entry.vertex_labels == vertex_labels;
+                });
+        return std::shared_ptr<const region_adjacency_graph>(cached, &cached->rag);
+    }
+
     /**
      * Construct a region adjacency graph from a graph cut in linear time.
      * Any edge with weight different from 0 belongs to the cut.
@@ -37,11 +37,11 @@ namespace hg {
             // cheap digraph!
             vector<vector<index_t>> adj_lists;
 
-            // precompute areas and smallest enclosing shapes
-            vector<array_1d<index_t>> areas;
+            // precompute areas (shared with other algorithms through the result cache) and smallest enclosing shapes
+            vector<std::shared_ptr<const array_1d<index_t>>> areas;
             array_2d<array_1d<index_t>> ses = xt::empty<array_1d<index_t>>({ntrees, ntrees});
             for (ti = first, i = 0; ti != last; ti++, i++) {
-                areas.push_back(attribute_area(**ti));
+                areas.push_back(cached_attribute_area(**ti));
                 for (tj = first, j = 0; tj != last; tj++, j++) {
                     if (j != i) {
                         ses(i, j) = attribute_smallest_enclosing_shape(**ti, **tj);
@@ -69,7 +69,7 @@ namespace hg {
                     bool keep = true;
                     for (index_t j = 0; j < i && keep; j++) {
                         auto ses_ij_n = ses(i, j)(n);
-                        if (areas[j](ses_ij_n) == areas[i](n)) {
+                        if ((*areas[j])(ses_ij_n) == (*areas[i])(n)) {
                             keep = false;
                             node_maps[i](n) = node_maps[j](ses_ij_n);
                         }
@@ -99,7 +99,7 @@ namespace hg {
                     for (j = 0; j < (index_t) ntrees; j++) {
                         if (i != j) {
                             auto ses_ij_n = ses(i, j)(n);
-                            if (areas[j](ses_ij_n) != areas[i](n)) {
+                            if ((*areas[j])(ses_ij_n) != (*areas[i])(n)) {
                                 adj_lists[node_maps[j](ses_ij_n)].push_back(represent_n);
                             }
                         }
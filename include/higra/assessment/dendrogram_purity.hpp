@@ -65,7 +65,8 @@ namespace hg {
         hg_assert_integral_value_type(leaf_labels);
 
         auto num_l = num_leaves(tree);
-        auto area = attribute_area(tree);
+        auto cached_area = cached_attribute_area(tree);
+        auto &area = *cached_area;
 
         auto max_label = xt::amax(leaf_labels)();
         size_t num_labels = max_label + 1;
@@ -15,6 +15,7 @@
 #include "../algo/tree.hpp"
 #include "../algo/rag.hpp"
 #include "../algo/horizontal_cuts.hpp"
+#include "../structure/sparse_intersection_table.hpp"
 #include <xtensor/xsort.hpp>
 
 namespace hg {
@@ -88,6 +89,10 @@ namespace hg {
             size_t back_track_k_right; // number of regions coming from right/second  child
         };
 
+        /**
+         * Sparse intersection table between the regions of the tree nodes (rows) and the regions of the
+         * ground truth (columns).
+         */
         template<typename value_t=index_t, typename tree_t, typename T>
         auto compute_card_intersection_tree_ground_truth(
                 const tree_t &tree,
@@ -96,23 +101,24 @@ namespace hg {
             auto &ground_truth = xground_truth.derived_cast();
             hg_assert_1d_array(ground_truth);
 
-            auto num_regions_ground_truth = xt::amax(ground_truth)() + 1;
-            array_2d<index_t> card_intersection_leaves({num_leaves(tree), (size_t) num_regions_ground_truth}, 0);
+            index_t num_regions_ground_truth = xt::amax(ground_truth)() + 1;
             if (vertex_map.size() <= 1) { // no rag
                 hg_assert_leaf_weights(tree, ground_truth);
-                for (auto i: leaves_iterator(tree)) {
-                    card_intersection_leaves(i, ground_truth(i))++;
-                }
+                return accumulate_sparse_intersection_table(
+                        tree,
+                        make_sparse_intersection_table<value_t>(xt::arange<index_t>(num_leaves(tree)),
+                                                                ground_truth,
+                                                                (index_t) num_leaves(tree),
+                                                                num_regions_ground_truth));
             } else { // tree on rag
                 hg_assert(vertex_map.size() == ground_truth.size(), "Vertex map and ground truth sizes do not match.");
-                for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
-                    card_intersection_leaves(vertex_map(i), ground_truth(i))++;
-                }
+                return accumulate_sparse_intersection_table(
+                        tree,
+                        make_sparse_intersection_table<value_t>(vertex_map,
+                                                                ground_truth,
+                                                                (index_t) num_leaves(tree),
+                                                                num_regions_ground_truth));
             }
-
-            array_2d<value_t> card_intersection = accumulate_sequential(tree, card_intersection_leaves,
-                                                                        accumulator_sum());
-            return card_intersection;
         };
 
     }
@@ -163,52 +169,30 @@ namespace hg {
 
             m_num_regions_ground_truth = xt::count_nonzero(region_gt_areas)();
 
-// TODO remove when xtensor MSVC witht he bug with xt::view(region_tree_area, xt::all(), xt::newaxis()) on 1d tensor
-#ifndef _MSC_VER
-            array_1d<index_t> region_tree_area;
-#else
-            array_nd<index_t> region_tree_area;
-#endif
-
             // for a tree node i, a gt region j: card_intersection(i, j) is the number of pixels in R_i cap R_j
-            array_2d<index_t> card_intersection_leaves{{num_leaves(tree), region_gt_areas.size()}, 0};
-            if (vertex_map.size() <= 1) { // no rag
-                hg_assert_leaf_weights(tree, ground_truth);
-                for (auto i: leaves_iterator(tree)) {
-                    card_intersection_leaves(i, ground_truth(i))++;
-                }
-                region_tree_area = attribute_area(tree);
-            } else { // tree on rag
-                hg_assert(vertex_map.size() == ground_truth.size(), "Vertex map and ground truth sizes do not match.");
-                for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
-                    card_intersection_leaves(vertex_map(i), ground_truth(i))++;
-                }
-                region_tree_area = attribute_area(tree,
-                                                  rag_accumulate(vertex_map, xt::ones<index_t>(vertex_map.shape()),
-                                                                 accumulator_counter()));
-            }
+            auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth(
+                    tree, ground_truth, vertex_map);
+            auto region_tree_area = card_intersection.row_sums();
 
-            array_2d<double> card_intersection = accumulate_sequential(tree, card_intersection_leaves,
-                                                                       accumulator_sum());
-
-            array_1d<double> scores;
-
-            switch (measure) {
-                case optimal_cut_measure::BCE:
-                    scores = xt::eval(xt::sum(
-                            card_intersection *
-                            xt::minimum(card_intersection / region_gt_areas,
-                                        card_intersection / xt::view(region_tree_area, xt::all(), xt::newaxis())),
-                            {1}));
-                    break;
-                case optimal_cut_measure::DHamming:
-                    scores = xt::eval(xt::amax(card_intersection, {1}));
-                    break;
-                case optimal_cut_measure::DCovering:
-                    auto card_union = xt::eval(-card_intersection + region_gt_areas +
-                                               xt::view(region_tree_area, xt::all(), xt::newaxis()));
-                    scores = xt::eval(xt::amax(card_intersection / card_union, {1}) * region_tree_area);
-                    break;
+            array_1d<double> scores = xt::zeros<double>({num_vertices(tree)});
+            for (auto i: leaves_to_root_iterator(tree)) {
+                double area_i = (double) region_tree_area(i);
+                double &score = scores(i);
+                for (index_t k = card_intersection.row_begin(i); k < card_intersection.row_begin(i + 1); k++) {
+                    double c = (double) card_intersection.values(k);
+                    double area_j = (double) region_gt_areas(card_intersection.columns(k));
+                    switch (measure) {
+                        case optimal_cut_measure::BCE:
+                            score += c * (std::min)(c / area_j, c / area_i);
+                            break;
+                        case optimal_cut_measure::DHamming:
+                            score = (std::max)(score, c);
+                            break;
+                        case optimal_cut_measure::DCovering:
+                            score = (std::max)(score, c / (area_j + area_i - c) * area_i);
+                            break;
+                    }
+                }
             }
 
             // initialize scoring for single region partitions (the node itself)
@@ -402,7 +386,7 @@ namespace hg {
         hg_assert_1d_array(ground_truth);
         max_regions = (std::min)(max_regions, num_leaves(tree));
 
-        auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth<double>(
+        auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth(
                 tree, ground_truth, vertex_map);
 
         auto hc_explorer = make_horizontal_cut_explorer(tree, altitudes);
@@ -417,10 +401,12 @@ namespace hg {
 
         for (index_t i = 0; i < num_cuts; i++) {
             auto hc = hc_explorer.horizontal_cut_from_index(i);
-            scores(i) = partition_scorer.score(xt::view(card_intersection, xt::keep(hc.nodes), xt::all()));
+            scores(i) = partition_scorer.score(card_intersection, hc.nodes);
         }
 
-        size_t num_regions_ground_truth = xt::count_nonzero(xt::view(card_intersection, root(tree), xt::all()))();;
+        auto tree_root = root(tree);
+        size_t num_regions_ground_truth = card_intersection.row_begin(tree_root + 1) -
+                                          card_intersection.row_begin(tree_root);
 
         return hg::fragmentation_curve<>{std::move(num_regions),
                                          std::move(scores),
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "../structure/array.hpp"
+#include "../structure/sparse_intersection_table.hpp"
 #include <vector>
 #include <xtensor/xview.hpp>
 
@@ -60,11 +61,107 @@ namespace hg {
         return result;
     }
 
+    /**
+     * Sparse version of card_intersections: for each ground truth, the sparse intersection table between the
+     * regions of the candidate partition (rows) and the regions of the ground truth (columns).
+     *
+     * @tparam value_type type of table values
+     * @tparam T1
+     * @tparam T2
+     * @param xcandidate candidate labelisation
+     * @param xground_truths a ground truth labelisation or an array of ground truth labelisations
+     * @return a vector of sparse_intersection_table
+     */
+    template<typename value_type=index_t, typename T1, typename T2>
+    auto sparse_card_intersections(const xt::xexpression<T1> &xcandidate,
+                                   const xt::xexpression<T2> &xground_truths) {
+        auto &candidate = xcandidate.derived_cast();
+        auto &ground_truths = xground_truths.derived_cast();
+
+        hg_assert_integral_value_type(candidate);
+        hg_assert_integral_value_type(ground_truths);
+
+        std::vector<sparse_intersection_table<value_type>> result;
+        index_t num_regions_candidate = xt::amax(candidate)() + 1;
+
+        auto compute = [&candidate, &result, num_regions_candidate](const auto &ground_truth) {
+            hg_assert_same_shape(candidate, ground_truth);
+            result.push_back(make_sparse_intersection_table<value_type>(candidate, ground_truth,
+                                                                        num_regions_candidate));
+        };
+
+        if (xt::same_shape(candidate.shape(), ground_truths.shape())) {
+            compute(ground_truths);
+        } else {
+            for (index_t i = 0; i < (index_t) ground_truths.shape()[0]; i++) {
+                compute(xt::view(ground_truths, i));
+            }
+        }
+
+        return result;
+    }
+
+    namespace partition_internal {
+
+        /**
+         * Area of the selected candidate regions (rows) and of the ground truth regions (columns) restricted to the
+         * selected rows of a sparse intersection table.
+         */
+        template<typename T, typename rows_t>
+        auto row_column_areas(const sparse_intersection_table<T> &card_intersection, const rows_t &rows) {
+            array_1d<double> row_areas = xt::zeros<double>({rows.size()});
+            array_1d<double> column_areas = xt::zeros<double>({(size_t) card_intersection.num_columns});
+            index_t ir = 0;
+            for (auto r: rows) {
+                for (index_t k = card_intersection.row_begin(r); k < card_intersection.row_begin(r + 1); k++) {
+                    row_areas(ir) += card_intersection.values(k);
+                    column_areas(card_intersection.columns(k)) += card_intersection.values(k);
+                }
+                ir++;
+            }
+            return std::make_pair(std::move(row_areas), std::move(column_areas));
+        }
+
+        /**
+         * Score of the selected rows of a sparse intersection table, row_score(c, row_area, column_area) is
+         * summed over the non zero entries c of each selected row if use_max is false, otherwise the
+         * maximum of row_score over the entries of a row is summed.
+         */
+        template<typename T, typename rows_t, typename row_score_t>
+        double sparse_score(const sparse_intersection_table<T> &card_intersection,
+                            const rows_t &rows,
+                            bool use_max,
+                            const row_score_t &row_score) {
+            auto areas = row_column_areas(card_intersection, rows);
+            auto &row_areas = areas.first;
+            auto &column_areas = areas.second;
+            double score = 0;
+            index_t ir = 0;
+            for (auto r: rows) {
+                double row_value = 0;
+                for (index_t k = card_intersection.row_begin(r); k < card_intersection.row_begin(r + 1); k++) {
+                    double v = row_score((double) card_intersection.values(k),
+                                         row_areas(ir),
+                                         column_areas(card_intersection.columns(k)));
+                    row_value = (use_max) ? (std::max)(row_value, v) : row_value + v;
+                }
+                score += row_value;
+                ir++;
+            }
+            return score / xt::sum(row_areas)();
+        }
+
+        template<typename T>
+        auto all_rows(const sparse_intersection_table<T> &card_intersection) {
+            return xt::arange<index_t>(card_intersection.num_rows());
+        }
+    }
+
     struct scorer_partition_BCE {
         template<typename T>
         static
         auto score(const xt::xexpression<T> &xcard_intersection) {
-            auto card_intersection = xcard_intersection.derived_cast();
+            auto &card_intersection = xcard_intersection.derived_cast();
             auto candidate_regions_area = xt::sum(card_intersection, {1});
 
             double score = xt::sum(
@@ -74,23 +171,55 @@ namespace hg {
 
             return score / xt::sum(candidate_regions_area)();
         }
+
+        template<typename T, typename rows_t>
+        static
+        double score(const sparse_intersection_table<T> &card_intersection, const rows_t &rows) {
+            return partition_internal::sparse_score(
+                    card_intersection, rows, false,
+                    [](double c, double row_area, double column_area) {
+                        return c * (std::min)(c / column_area, c / row_area);
+                    });
+        }
+
+        template<typename T>
+        static
+        double score(const sparse_intersection_table<T> &card_intersection) {
+            return score(card_intersection, partition_internal::all_rows(card_intersection));
+        }
     };
 
     struct scorer_partition_DHamming {
         template<typename T>
         static
         auto score(const xt::xexpression<T> &xcard_intersection) {
-            auto card_intersection = xcard_intersection.derived_cast();
+            auto &card_intersection = xcard_intersection.derived_cast();
 
             return (xt::sum(xt::amax(card_intersection, {1}))() / xt::sum(card_intersection)());
         }
+
+        template<typename T, typename rows_t>
+        static
+        double score(const sparse_intersection_table<T> &card_intersection, const rows_t &rows) {
+            return partition_internal::sparse_score(
+                    card_intersection, rows, true,
+                    [](double c, double, double) {
+                        return c;
+                    });
+        }
+
+        template<typename T>
+        static
+        double score(const sparse_intersection_table<T> &card_intersection) {
+            return score(card_intersection, partition_internal::all_rows(card_intersection));
+        }
     };
 
     struct scorer_partition_DCovering {
         template<typename T>
         static
         auto score(const xt::xexpression<T> &xcard_intersection) {
-            auto card_intersection = xcard_intersection.derived_cast();
+            auto &card_intersection = xcard_intersection.derived_cast();
             auto candidate_regions_area = xt::sum(card_intersection, {1});
 
             auto card_union = -card_intersection + xt::sum(card_intersection, {0}) +
@@ -100,6 +229,22 @@ namespace hg {
 
             return score / xt::sum(candidate_regions_area)();
         }
+
+        template<typename T, typename rows_t>
+        static
+        double score(const sparse_intersection_table<T> &card_intersection, const rows_t &rows) {
+            return partition_internal::sparse_score(
+                    card_intersection, rows, true,
+                    [](double c, double row_area, double column_area) {
+                        return c / (row_area + column_area - c) * row_area;
+                    });
+        }
+
+        template<typename T>
+        static
+        double score(const sparse_intersection_table<T> &card_intersection) {
+            return score(card_intersection, partition_internal::all_rows(card_intersection));
+        }
     };
 
     template<typename T, typename scorer_t>
@@ -115,7 +260,7 @@ namespace hg {
     auto assess_partition(const xt::xexpression<T1> &xcandidate,
                           const xt::xexpression<T2> &xground_truths,
                           const scorer_t &scorer) {
-        auto card_intersections = hg::card_intersections<double>(xcandidate, xground_truths);
+        auto card_intersections = hg::sparse_card_intersections(xcandidate, xground_truths);
         return assess_partition(card_intersections, scorer);
     }
 
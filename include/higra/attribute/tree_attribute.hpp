@@ -51,6 +51,20 @@ namespace hg {
         return attribute_area(tree, xt::ones<index_t>({num_leaves(tree)}));
     }
 
+    /**
+     * Area of the nodes of the given tree (see attribute_area) stored in the global result cache: the area of a tree
+     * is computed once for all the algorithms working on this tree.
+     *
+     * @param tree input tree
+     * @return a shared pointer on a constant 1d array
+     */
+    inline
+    auto cached_attribute_area(const tree &tree) {
+        return result_cache::global().get_or_compute<array_1d<index_t>>(tree, "attribute_area", [&tree]() {
+            return array_1d<index_t>(attribute_area(tree));
+        });
+    }
+
     /**
      * The volume of a node n of the tree t is defined recursively as:
      *    volume(n) = abs(altitude(n) - altitude(parent(n)) * area(n) + sum_{c in children(n, t)} volume(c)
@@ -78,7 +92,7 @@ namespace hg {
         xt::view(volume, xt::range(0, num_leaves(tree))) = 0;
         for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
             volume(i) = std::fabs(node_altitude(i) - node_altitude(parent(i))) * node_area(i);
-            for (auto c: tree.children(i)) {
+            for (auto c: children_iterator(i, tree)) {
                 volume(i) += volume(c);
             }
         }
@@ -130,7 +144,7 @@ namespace hg {
         using value_type = typename T::value_type;
 
         if (increasing_altitudes) {
-            auto min_depth = xt::empty_like(altitudes);
+            array_1d<value_type> min_depth = array_1d<value_type>::from_shape(altitudes.shape());
             xt::noalias(xt::view(min_depth, xt::range(0, num_leaves(tree)))) =
                     xt::view(xt::index_view(altitudes, tree.parents()), xt::range(0, num_leaves(tree)));
             for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
@@ -150,7 +164,7 @@ namespace hg {
             }
             return xt::eval(xt::index_view(altitudes, tree.parents()) - min_depth);
         } else {
-            auto max_depth = xt::empty_like(altitudes);
+            array_1d<value_type> max_depth = array_1d<value_type>::from_shape(altitudes.shape());
             xt::noalias(xt::view(max_depth, xt::range(0, num_leaves(tree)))) =
                     xt::view(xt::index_view(altitudes, tree.parents()), xt::range(0, num_leaves(tree)));
             for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
@@ -260,7 +274,7 @@ namespace hg {
         // identify path to the deepest extrema
         array_1d<index_t> ref_son({num_vertices(tree)}, invalid_index);
         if (increasing_altitudes) {
-            auto min_depth = xt::empty_like(altitudes);
+            array_1d<value_type> min_depth = array_1d<value_type>::from_shape(altitudes.shape());
             for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
                 min_depth(n) = (std::numeric_limits<value_type>::max)();
                 bool flag = true;
@@ -278,7 +292,7 @@ namespace hg {
                 }
             }
         } else {
-            auto max_depth = xt::empty_like(altitudes);
+            array_1d<value_type> max_depth = array_1d<value_type>::from_shape(altitudes.shape());
             for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
                 max_depth(n) = std::numeric_limits<value_type>::lowest();
                 bool flag = true;
@@ -10,9 +10,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 namespace hg {
@@ -22,11 +24,20 @@ namespace hg {
         static const std::size_t MAX_MSG_SIZE = 8096;
         using callback_list = std::vector<std::function<void(const std::string &)>>;
 
-        static bool &trace_enabled() {
-            static bool value{false};
+        static std::atomic<bool> &trace_enabled() {
+            static std::atomic<bool> value{false};
             return value;
         }
 
+        /**
+         * Mutex protecting the callback list: any modification of the list returned by callbacks() must be done
+         * while holding this mutex as messages may be emitted concurrently from several threads.
+         */
+        static std::mutex &callbacks_mutex() {
+            static std::mutex mutex;
+            return mutex;
+        }
+
         static callback_list &callbacks() {
             static callback_list callbacks{
                     [](const std::string &msg) { std::cout << msg; }}; //not the perfect initialization...
@@ -38,7 +49,13 @@ namespace hg {
             char message[MAX_MSG_SIZE];
             snprintf(message, MAX_MSG_SIZE, format, std::forward<Args>(args)...);
             std::string sm(message);
-            for (auto c: callbacks()) {
+            // callbacks are called on a copy of the list: a callback may need to acquire other locks (eg. the Python GIL)
+            callback_list current_callbacks;
+            {
+                std::lock_guard<std::mutex> lock(callbacks_mutex());
+                current_callbacks = callbacks();
+            }
+            for (auto &c: current_callbacks) {
                 c(sm);
             }
 
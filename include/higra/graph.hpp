@@ -12,6 +12,7 @@
 #include "utils.hpp"
 #include "structure/undirected_graph.hpp"
 #include "structure/regular_graph.hpp"
+#include "structure/grid_graph.hpp"
 #include "structure/tree_graph.hpp"
 
 namespace hg {
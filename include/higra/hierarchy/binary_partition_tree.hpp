@@ -13,35 +13,18 @@
 #include "common.hpp"
 #include "../graph.hpp"
 #include "hierarchy_core.hpp"
-#include "../structure/fibonacci_heap.hpp"
+#include "../structure/indexed_heap.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
+#include <algorithm>
+#include <numeric>
 #include <string>
+#include <type_traits>
 
 namespace hg {
 
     namespace binary_partition_tree_internal {
 
-        template<typename T>
-        struct heap_element {
-            using self_t = heap_element<T>;
-            T value;
-            index_t index;
-
-            bool operator==(const self_t &rhs) const { return value == rhs.value; }
-
-            bool operator!=(const self_t &rhs) const { return value != rhs.value; }
-
-            bool operator<(const self_t &rhs) const { return value < rhs.value; }
-
-            bool operator>(const self_t &rhs) const { return value > rhs.value; }
-
-            bool operator<=(const self_t &rhs) const { return value <= rhs.value; }
-
-            bool operator>=(const self_t &rhs) const { return value >= rhs.value; }
-
-        };
-
         /**
          * This structure is provided by the binary partition algorithm when two nodes are merged in order to
          * compute the edge weight between the newly created node and one of its neighbouring node.
@@ -431,7 +414,193 @@ namespace hg {
             }
         };
 
+        /**
+         * Graph being reduced by the binary partition tree algorithm.
+         *
+         * The end points of each edge are stored in two flat arrays and the adjacency lists of all the vertices are
+         * stored contiguously in a single array of edge indices: the adjacency list of a new vertex is appended at the
+         * end of this array. Removed edges and edges of merged vertices are not erased from the adjacency lists, they
+         * are skipped when the lists are traversed and dropped when the array is compacted.
+         */
+        struct merge_graph {
+            array_1d<index_t> sources;
+            array_1d<index_t> targets;
+            std::vector<index_t> adjacency;
+            array_1d<index_t> begin;
+            array_1d<index_t> end;
+
+            /**
+             * Copy the given graph, self loops are not inserted in the adjacency lists.
+             *
+             * @param graph input graph
+             * @param max_num_vertices maximal number of vertices (including the vertices of the input graph)
+             */
+            template<typename graph_t>
+            merge_graph(const graph_t &graph, index_t max_num_vertices) {
+                index_t num_v = (index_t) num_vertices(graph);
+                index_t num_e = (index_t) num_edges(graph);
+                sources = array_1d<index_t>::from_shape({(size_t) num_e});
+                targets = array_1d<index_t>::from_shape({(size_t) num_e});
+                begin = xt::zeros<index_t>({(size_t) max_num_vertices});
+                end = xt::zeros<index_t>({(size_t) max_num_vertices});
+
+                for (auto e: edge_iterator(graph)) {
+                    auto ei = index(e, graph);
+                    auto s = source(e, graph);
+                    auto t = target(e, graph);
+                    sources(ei) = s;
+                    targets(ei) = t;
+                    if (s != t) {
+                        end(s)++;
+                        end(t)++;
+                    }
+                }
+
+                index_t num_entries = 0;
+                for (index_t v = 0; v < num_v; v++) {
+                    begin(v) = num_entries;
+                    num_entries += end(v);
+                    end(v) = begin(v);
+                }
+
+                adjacency.reserve(4 * num_entries + num_v);
+                adjacency.resize(num_entries);
+                for (index_t ei = 0; ei < num_e; ei++) {
+                    if (sources(ei) != targets(ei)) {
+                        adjacency[end(sources(ei))++] = ei;
+                        adjacency[end(targets(ei))++] = ei;
+                    }
+                }
+            }
+
+            index_t other_vertex(index_t edge, index_t vertex) const {
+                return (sources(edge) == vertex) ? targets(edge) : sources(edge);
+            }
+
+            void set_edge(index_t edge, index_t source, index_t target) {
+                sources(edge) = source;
+                targets(edge) = target;
+            }
+
+            /**
+             * Start the adjacency list of a new vertex: the vertex must be greater than all the existing vertices.
+             * @param vertex
+             */
+            void add_vertex(index_t vertex) {
+                begin(vertex) = end(vertex) = (index_t) adjacency.size();
+            }
+
+            /**
+             * Append an edge to the adjacency list of the last added vertex.
+             * @param vertex
+             * @param edge
+             */
+            void add_out_edge(index_t vertex, index_t edge) {
+                adjacency.push_back(edge);
+                end(vertex)++;
+            }
 
+            /**
+             * Remove the adjacency lists of the dead vertices and the dead edges from the remaining lists.
+             *
+             * As adjacency lists are stored by increasing vertex indices, the array is compacted in place.
+             *
+             * @param num_vertices current number of vertices
+             * @param is_live_vertex predicate on vertex indices
+             * @param is_live_edge predicate on edge indices
+             */
+            template<typename vertex_predicate_t, typename edge_predicate_t>
+            void compact(index_t num_vertices, const vertex_predicate_t &is_live_vertex,
+                         const edge_predicate_t &is_live_edge) {
+                index_t position = 0;
+                for (index_t v = 0; v < num_vertices; v++) {
+                    index_t b = begin(v);
+                    index_t e = end(v);
+                    begin(v) = position;
+                    if (is_live_vertex(v)) {
+                        for (index_t i = b; i < e; i++) {
+                            if (is_live_edge(adjacency[i])) {
+                                adjacency[position++] = adjacency[i];
+                            }
+                        }
+                    }
+                    end(v) = position;
+                }
+                adjacency.resize(position);
+            }
+        };
+
+        /**
+         * Search the neighbours of two regions being merged and store them in new_neighbours.
+         *
+         * Edges linking the two regions together are removed with remove_edge.
+         *
+         * @param g graph being reduced
+         * @param region1 first merged region
+         * @param region2 second merged region
+         * @param new_neighbours output list of neighbours (cleared by the function)
+         * @param new_neighbour_indices work array filled with invalid_index (left unchanged by the function)
+         * @param is_live_edge predicate on edge indices
+         * @param remove_edge function removing an edge from the graph
+         */
+        template<typename neighbours_t, typename edge_predicate_t, typename remove_edge_t>
+        void find_new_neighbours(const merge_graph &g,
+                                 index_t region1,
+                                 index_t region2,
+                                 neighbours_t &new_neighbours,
+                                 array_1d<index_t> &new_neighbour_indices,
+                                 const edge_predicate_t &is_live_edge,
+                                 const remove_edge_t &remove_edge) {
+            new_neighbours.clear();
+            auto explore_region = [&](index_t region, index_t other_region) {
+                for (index_t i = g.begin(region); i < g.end(region); i++) {
+                    auto e = g.adjacency[i];
+                    if (!is_live_edge(e)) {
+                        continue;
+                    }
+                    auto n = g.other_vertex(e, region);
+                    if (n != other_region) {
+                        if (new_neighbour_indices[n] != invalid_index) {
+                            new_neighbours[new_neighbour_indices[n]].second_edge_index() = e;
+                        } else {
+                            new_neighbour_indices[n] = new_neighbours.size();
+                            new_neighbours.emplace_back(n, e);
+                        }
+                    } else { // may happen with multiple edges
+                        remove_edge(e);
+                    }
+                }
+            };
+
+            explore_region(region1, region2);
+            explore_region(region2, region1);
+            for (auto &n: new_neighbours) {
+                new_neighbour_indices[n.neighbour_vertex()] = invalid_index;
+            }
+        }
+
+        /**
+         * A weighting function is reducible if for any clusters i, j, k: d(i U j, k) >= min(d(i, k), d(j, k)),
+         * the distance being infinite between non adjacent clusters.
+         *
+         * Reducible weighting functions can be used with binary_partition_tree_reciprocal_nearest_neighbours.
+         *
+         * Note that the Ward linkage is reducible on complete graphs only: on a sparse graph, the Ward distance
+         * between two adjacent clusters may decrease after a merge (see the "ward linkage non increasing" test).
+         *
+         * @tparam weighter
+         */
+        template<typename weighter>
+        struct is_reducible_linkage : std::false_type {
+        };
+
+        template<typename T>
+        struct is_reducible_linkage<binary_partition_tree_complete_linkage_weighting_functor<T>> : std::true_type {
+        };
+
+        template<typename T>
+        struct is_reducible_linkage<binary_partition_tree_average_linkage_weighting_functor<T>> : std::true_type {
+        };
     }
 
     /**
@@ -453,7 +622,7 @@ namespace hg {
      *  ...
      *
      *  template<typename graph_t, typename neighbours_t>
-     *  void operator()(const graph_t &g,               // the current state of the graph
+     *  void operator()(const graph_t &g,               // the input graph
      *                  index_t fusion_edge_index,      // the edge between the two vertices being merged
      *                  index_t new_region,             // the new vertex in the graph
      *                  index_t merged_region1,         // the first vertex merged
@@ -476,7 +645,12 @@ namespace hg {
      *  - new_edge_weight(): weight of the new edge (THIS HAS TO BE DEFINED IN THE WEIGHTING FUNCTION)
      *  - new_edge_index(): the index of the new edge: the weighting function will probably have to track new weight values
      *
-     * Example of weighting function: binary_partition_tree_min_linkage
+     * Example of weighting function: binary_partition_tree_complete_linkage_weighting_functor
+     *
+     * The graph being reduced is stored in flat arrays (edge end points and contiguous adjacency lists, see
+     * binary_partition_tree_internal::merge_graph) and the edges are ordered with an indexed d-ary heap: edges that
+     * disappear during a merge are really removed from the heap. Edges of equal weights are processed by increasing
+     * edge index.
      *
      * @tparam graph_t
      * @tparam weighter
@@ -490,117 +664,286 @@ namespace hg {
     auto
     binary_partition_tree(const graph_t &graph, const xt::xexpression<T> &xedge_weights, weighter weight_function) {
         using weight_t = typename T::value_type;
-        using heap_t = fibonacci_heap<binary_partition_tree_internal::heap_element<weight_t> >;
 
         auto &edge_weights = xedge_weights.derived_cast();
         hg_assert_edge_weights(graph, edge_weights);
 
-        auto g = copy_graph<undirected_graph<hash_setS> >(graph); // optimized for removal
+        index_t num_points = (index_t) num_vertices(graph);
+        index_t num_nodes_tree = num_points * 2 - 1;
 
-        auto num_points = num_vertices(g);
-        auto num_nodes_tree = num_points * 2 - 1;
+        array_1d<index_t> parents = xt::arange<index_t>(num_nodes_tree);
+        array_1d<weight_t> levels = xt::zeros<weight_t>({(size_t) num_nodes_tree});
 
-        array_1d<index_t> parents = xt::arange(num_nodes_tree);
-        array_1d<weight_t> levels = xt::zeros<weight_t>({num_nodes_tree});
+        binary_partition_tree_internal::merge_graph g(graph, num_nodes_tree);
 
         // optimization to detect already visited neighbours during neighbour search
-        array_1d<index_t> new_neighbour_indices({num_nodes_tree}, invalid_index);
-
-        // active edges are in the heap and still present in the graph (removed edges are leazily left in the heap)
-        // TODO: check for performance impact
-        array_1d<bool> active = xt::zeros<bool>({num_edges(g)});
+        array_1d<index_t> new_neighbour_indices({(size_t) num_nodes_tree}, invalid_index);
 
         // special structure to store the list of neighbours adjacent to the fused regions.
         std::vector<binary_partition_tree_internal::new_neighbour<weight_t> > new_neighbours;
         const decltype(new_neighbours) &const_new_neighbours = new_neighbours;
 
-        // init heap
-        heap_t heap;
-        array_1d<typename heap_t::value_handle> heap_handles({num_edges(g)}, nullptr);
-
-        for (auto v: vertex_iterator(graph)) {
-            for (auto &e: out_edge_iterator(v, g)) {
-                if (!active(e)) {
-                    heap_handles(e) = heap.push({edge_weights(e), e});
-                    active(e) = true;
-                }
+        // an edge is in the heap if and only if it is still present in the graph
+        index_t num_edges_graph = (index_t) num_edges(graph);
+        indexed_heap<weight_t> heap(num_edges_graph);
+        for (index_t e = 0; e < num_edges_graph; e++) {
+            if (g.sources(e) != g.targets(e)) {
+                heap.push(e, edge_weights(e));
             }
         }
 
+        auto is_live_vertex = [&parents](index_t v) { return parents(v) == v; };
+        auto is_live_edge = [&heap](index_t e) { return heap.contains(e); };
+
         // main loop
-        size_t current_num_nodes_tree = num_points;
+        index_t current_num_nodes_tree = num_points;
         while (!heap.empty() && current_num_nodes_tree < num_nodes_tree) {
 
-            auto heap_handle = heap.top();
-            auto min_element = heap_handle->get_value();
-
-            auto fusion_edge_index = min_element.index;
-            auto fusion_edge_weight = min_element.value;
-
+            auto fusion_edge_index = heap.top();
+            auto fusion_edge_weight = heap.top_value();
             heap.pop();
-            heap_handles[fusion_edge_index] = nullptr;
-
-            if (active[fusion_edge_index]) {
-                active[fusion_edge_index] = false;
-                // create new region, update tree
-                auto new_parent = g.add_vertex();
-                auto fusion_edge = edge_from_index(fusion_edge_index, g);
-                auto region1 = source(fusion_edge, g);
-                auto region2 = target(fusion_edge, g);
-                parents[region1] = new_parent;
-                parents[region2] = new_parent;
-                levels[new_parent] = fusion_edge_weight;
-                current_num_nodes_tree++;
-
-                // remove fusion edge
-                remove_edge(fusion_edge_index, g);
-                active[fusion_edge_index] = false;
-
-                // search for neighbours of region1 and region2 and store them in new_neighbours
-                new_neighbours.clear();
-                auto explore_region = [&active, &g, &new_neighbours, &new_neighbour_indices](
-                        index_t region, index_t other_region) {
-                    for (auto e: out_edge_iterator(region, g)) {
-                        auto n = other_vertex(e, region, g);
-                        if (n != other_region) { // may happen with multiple edges
-                            if (new_neighbour_indices[n] != invalid_index) {
-                                new_neighbours[new_neighbour_indices[n]].second_edge_index() = e;
-                            } else {
-                                new_neighbour_indices[n] = new_neighbours.size();
-                                new_neighbours.emplace_back(n, e);
-                            }
-                        } else {
-                            active[index(e, g)] = false;
-                        }
-                    }
-                };
 
-                explore_region(region1, region2);
-                explore_region(region2, region1);
-                for (auto &n: new_neighbours) {
-                    new_neighbour_indices[n.neighbour_vertex()] = invalid_index;
+            // create new region, update tree
+            auto new_parent = current_num_nodes_tree++;
+            auto region1 = g.sources(fusion_edge_index);
+            auto region2 = g.targets(fusion_edge_index);
+            parents[region1] = new_parent;
+            parents[region2] = new_parent;
+            levels[new_parent] = fusion_edge_weight;
+
+            // search for neighbours of region1 and region2 and store them in new_neighbours
+            binary_partition_tree_internal::find_new_neighbours(g, region1, region2,
+                                                                new_neighbours, new_neighbour_indices,
+                                                                is_live_edge,
+                                                                [&heap](index_t e) { heap.erase(e); });
+
+            // update edge weights
+            g.add_vertex(new_parent);
+            if (!new_neighbours.empty()) { // should only happen at last iteration
+                // external callback : compute new edge weights
+                weight_function(graph, fusion_edge_index, new_parent, region1, region2, const_new_neighbours);
+
+                // process new weights, update heap and things
+                for (auto &nn: new_neighbours) {
+                    if (nn.num_edges() > 1) {
+                        heap.erase(nn.second_edge_index());
+                    }
+                    g.set_edge(nn.first_edge_index(), nn.neighbour_vertex(), new_parent);
+                    heap.update(nn.first_edge_index(), nn.new_edge_weight());
+                    g.add_out_edge(new_parent, nn.first_edge_index());
                 }
+            }
+
+            // each edge in the graph appears in 2 adjacency lists
+            if (g.adjacency.size() > 4 * heap.size() + (size_t) num_points) {
+                g.compact(current_num_nodes_tree, is_live_vertex, is_live_edge);
+            }
+        }
+        return make_node_weighted_tree(tree(parents), std::move(levels));
+    }
+
+    /**
+     * Algorithms available to compute a binary partition tree with a reducible linkage
+     * (see binary_partition_tree_internal::is_reducible_linkage).
+     *
+     *  - heap: binary_partition_tree, the edge of minimal weight is extracted from a global heap at each step;
+     *  - reciprocal_nearest_neighbours: binary_partition_tree_reciprocal_nearest_neighbours, all the pairs of
+     *    reciprocal nearest neighbours are merged in rounds, nearest neighbours being searched in parallel
+     *    (multi-threaded if higra is built with TBB).
+     *
+     * Both algorithms produce the same hierarchy up to ties (edges or clusters with equal weights), altitudes may
+     * differ by rounding errors.
+     */
+    enum class bpt_linkage_algorithm {
+        heap,
+        reciprocal_nearest_neighbours
+    };
+
+    /**
+     * Compute the binary partition tree of the graph with a reducible weighting function by merging pairs of
+     * reciprocal nearest neighbours.
+     *
+     * The weighting function must be reducible (see binary_partition_tree_internal::is_reducible_linkage), for any
+     * clusters i, j, k: d(i U j, k) >= min(d(i, k), d(j, k)). With such a function, merging two reciprocal nearest
+     * neighbours does not modify the nearest neighbour of any other cluster: all the pairs of reciprocal nearest
+     * neighbours can thus be merged in any order and the result is the same as binary_partition_tree (up to ties).
+     *
+     * The algorithm proceeds by rounds:
+     *
+     *  1 - the nearest neighbour of each cluster whose neighbourhood has changed during the previous round is computed
+     *      (in parallel);
+     *  2 - all the pairs of reciprocal nearest neighbours are merged, edge weights are updated with the weighting
+     *      function (see binary_partition_tree) and the neighbours of the new clusters are marked as changed;
+     *  3 - repeat until no cluster has changed.
+     *
+     * Nearest neighbours are defined by the edge weights, ties being broken by edge indices. The nodes of the
+     * resulting tree are finally sorted by increasing altitude, in order to match the node order of
+     * binary_partition_tree.
+     *
+     * Note that during the merges, the vertex indices provided to the weighting function (new_region,
+     * merged_region1 and merged_region2) are given in the order of creation and not in the order of the final tree.
+     *
+     * @tparam graph_t
+     * @tparam weighter
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param weight_function a reducible weighting function
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename weighter, typename T>
+    auto binary_partition_tree_reciprocal_nearest_neighbours(const graph_t &graph,
+                                                             const xt::xexpression<T> &xedge_weights,
+                                                             weighter weight_function) {
+        static_assert(binary_partition_tree_internal::is_reducible_linkage<weighter>::value,
+                      "The weighting function must be reducible (see is_reducible_linkage).");
+        using weight_t = typename T::value_type;
+
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(graph, edge_weights);
 
-                // update edge weights
-                if (!new_neighbours.empty()) { // should only happen at last iteration
-                    // external callback : compute new edge weights
-                    weight_function(g, fusion_edge_index, new_parent, region1, region2, const_new_neighbours);
+        index_t num_points = (index_t) num_vertices(graph);
+        index_t num_nodes_tree = num_points * 2 - 1;
+        index_t num_edges_graph = (index_t) num_edges(graph);
+
+        binary_partition_tree_internal::merge_graph g(graph, num_nodes_tree);
+
+        // current weight of each edge
+        array_1d<weight_t> weights = edge_weights;
+        array_1d<bool> live = xt::not_equal(g.sources, g.targets);
+        index_t num_live_edges = (index_t) xt::sum(live)();
+        auto is_live_edge = [&live](index_t e) { return live(e); };
+
+        // merge forest: vertices are numbered in creation order
+        array_1d<index_t> parents = xt::arange<index_t>(num_nodes_tree);
+        array_1d<weight_t> levels = xt::zeros<weight_t>({(size_t) num_nodes_tree});
+        auto is_live_vertex = [&parents](index_t v) { return parents(v) == v; };
+
+        // edge linking each cluster to its nearest neighbour
+        array_1d<index_t> nearest_edge({(size_t) num_nodes_tree}, invalid_index);
+        auto edge_less = [&weights](index_t e1, index_t e2) {
+            return weights(e1) < weights(e2) || (!(weights(e2) < weights(e1)) && e1 < e2);
+        };
+
+        // clusters whose nearest neighbour has to be recomputed
+        std::vector<index_t> changed(num_points);
+        std::iota(changed.begin(), changed.end(), 0);
+        array_1d<bool> is_changed = xt::zeros<bool>({(size_t) num_nodes_tree});
+        xt::view(is_changed, xt::range(0, num_points)) = true;
+        auto mark_changed = [&changed, &is_changed](index_t v) {
+            if (!is_changed(v)) {
+                is_changed(v) = true;
+                changed.push_back(v);
+            }
+        };
+
+        array_1d<index_t> new_neighbour_indices({(size_t) num_nodes_tree}, invalid_index);
+        std::vector<binary_partition_tree_internal::new_neighbour<weight_t> > new_neighbours;
+        const decltype(new_neighbours) &const_new_neighbours = new_neighbours;
+
+        std::vector<index_t> fusion_edges;
+        index_t current_num_nodes_tree = num_points;
+        while (!changed.empty()) {
+            // nearest neighbours of changed clusters
+            parfor(0, (index_t) changed.size(), [&](index_t i) {
+                auto v = changed[i];
+                if (!is_live_vertex(v)) {
+                    return;
+                }
+                index_t best = invalid_index;
+                for (index_t j = g.begin(v); j < g.end(v); j++) {
+                    auto e = g.adjacency[j];
+                    if (live(e) && (best == invalid_index || edge_less(e, best))) {
+                        best = e;
+                    }
+                }
+                nearest_edge(v) = best;
+            });
+
+            // reciprocal nearest neighbours: a pair of unchanged clusters cannot be reciprocal as it would have
+            // been merged during a previous round
+            fusion_edges.clear();
+            for (auto v: changed) {
+                is_changed(v) = false;
+                if (!is_live_vertex(v) || nearest_edge(v) == invalid_index) {
+                    continue;
+                }
+                auto e = nearest_edge(v);
+                if (nearest_edge(g.other_vertex(e, v)) == e) {
+                    fusion_edges.push_back(e);
+                }
+            }
+            changed.clear();
+            std::sort(fusion_edges.begin(), fusion_edges.end(), edge_less);
+            fusion_edges.erase(std::unique(fusion_edges.begin(), fusion_edges.end()), fusion_edges.end());
+
+            // merges: reciprocal pairs are disjoint, each merge only modifies edges adjacent to the merged clusters
+            for (auto fusion_edge_index: fusion_edges) {
+                auto new_parent = current_num_nodes_tree++;
+                auto region1 = g.sources(fusion_edge_index);
+                auto region2 = g.targets(fusion_edge_index);
+                parents(region1) = new_parent;
+                parents(region2) = new_parent;
+                levels(new_parent) = weights(fusion_edge_index);
+                live(fusion_edge_index) = false;
+                num_live_edges--;
+
+                binary_partition_tree_internal::find_new_neighbours(g, region1, region2,
+                                                                    new_neighbours, new_neighbour_indices,
+                                                                    is_live_edge,
+                                                                    [&live, &num_live_edges](index_t e) {
+                                                                        live(e) = false;
+                                                                        num_live_edges--;
+                                                                    });
+
+                g.add_vertex(new_parent);
+                if (!new_neighbours.empty()) {
+                    weight_function(graph, fusion_edge_index, new_parent, region1, region2, const_new_neighbours);
 
-                    // process new weights, update heap and things
                     for (auto &nn: new_neighbours) {
                         if (nn.num_edges() > 1) {
-                            active[nn.second_edge_index()] = false;
-                            // not removed from heap: maybe not necessary
-                            remove_edge(nn.second_edge_index(), g);
+                            live(nn.second_edge_index()) = false;
+                            num_live_edges--;
                         }
-                        set_edge(nn.first_edge_index(), nn.neighbour_vertex(), new_parent, g);
-                        heap.update(heap_handles[nn.first_edge_index()], {nn.new_edge_weight(), nn.first_edge_index()});
-                        active[nn.first_edge_index()] = true;
+                        g.set_edge(nn.first_edge_index(), nn.neighbour_vertex(), new_parent);
+                        weights(nn.first_edge_index()) = nn.new_edge_weight();
+                        g.add_out_edge(new_parent, nn.first_edge_index());
+                        mark_changed(nn.neighbour_vertex());
                     }
+                    mark_changed(new_parent);
+                }
+
+                // each edge in the graph appears in 2 adjacency lists
+                if (g.adjacency.size() > (size_t) (4 * num_live_edges + num_points)) {
+                    g.compact(current_num_nodes_tree, is_live_vertex, is_live_edge);
                 }
             }
         }
-        return make_node_weighted_tree(tree(parents), std::move(levels));
+
+        // sort the non leaf nodes by altitude, children being created before their parents, the sort key of a node
+        // is the maximum of its altitude and of the keys of its children (protection against rounding errors)
+        array_1d<weight_t> keys = levels;
+        for (index_t i = 0; i < current_num_nodes_tree; i++) {
+            if (parents(i) != i) {
+                keys(parents(i)) = (std::max)(keys(parents(i)), keys(i));
+            }
+        }
+        std::vector<index_t> order(current_num_nodes_tree - num_points);
+        std::iota(order.begin(), order.end(), num_points);
+        std::stable_sort(order.begin(), order.end(), [&keys](index_t i, index_t j) { return keys(i) < keys(j); });
+
+        array_1d<index_t> ranks = xt::arange<index_t>(num_nodes_tree);
+        for (index_t i = 0; i < (index_t) order.size(); i++) {
+            ranks(order[i]) = num_points + i;
+        }
+
+        array_1d<index_t> sorted_parents = xt::arange<index_t>(num_nodes_tree);
+        array_1d<weight_t> sorted_levels = xt::zeros<weight_t>({(size_t) num_nodes_tree});
+        for (index_t i = 0; i < current_num_nodes_tree; i++) {
+            sorted_parents(ranks(i)) = ranks(parents(i));
+            sorted_levels(ranks(i)) = levels(i);
+        }
+        return make_node_weighted_tree(tree(sorted_parents), std::move(sorted_levels));
     }
 
 
@@ -624,7 +967,7 @@ namespace hg {
      */
     template<typename graph_t, typename T>
     auto binary_partition_tree_min_linkage(const graph_t &graph, const xt::xexpression<T> &xedge_weights) {
-        auto res = bpt_canonical(graph, xedge_weights);
+        auto res = bpt_canonical_edge_list(graph, xedge_weights);
         return make_node_weighted_tree(std::move(res.tree), std::move(res.altitudes));
     }
 
@@ -644,15 +987,20 @@ namespace hg {
      * @tparam T
      * @param graph
      * @param xedge_weights
+     * @param algorithm see bpt_linkage_algorithm
      * @return a node weighted tree
      */
     template<typename graph_t, typename T>
-    auto binary_partition_tree_complete_linkage(const graph_t &graph, const xt::xexpression<T> &xedge_weights) {
-        return binary_partition_tree(
-                graph,
-                xedge_weights,
-                binary_partition_tree_internal::binary_partition_tree_complete_linkage_weighting_functor<T>(
-                        xedge_weights));
+    auto binary_partition_tree_complete_linkage(const graph_t &graph,
+                                                const xt::xexpression<T> &xedge_weights,
+                                                bpt_linkage_algorithm algorithm = bpt_linkage_algorithm::heap) {
+        binary_partition_tree_internal::binary_partition_tree_complete_linkage_weighting_functor<T>
+                weight_function(xedge_weights);
+        if (algorithm == bpt_linkage_algorithm::reciprocal_nearest_neighbours) {
+            return binary_partition_tree_reciprocal_nearest_neighbours(graph, xedge_weights,
+                                                                       std::move(weight_function));
+        }
+        return binary_partition_tree(graph, xedge_weights, std::move(weight_function));
     }
 
     /**
@@ -674,18 +1022,21 @@ namespace hg {
      * @param graph
      * @param xedge_weights
      * @param xedge_weight_weights
+     * @param algorithm see bpt_linkage_algorithm
      * @return a node weighted tree
      */
     template<typename graph_t, typename T>
     auto binary_partition_tree_average_linkage(const graph_t &graph,
                                                const xt::xexpression<T> &xedge_weights,
-                                               const xt::xexpression<T> &xedge_weight_weights) {
-        return binary_partition_tree(
-                graph,
-                xedge_weights,
-                binary_partition_tree_internal::binary_partition_tree_average_linkage_weighting_functor<T>(
-                        xedge_weights,
-                        xedge_weight_weights));
+                                               const xt::xexpression<T> &xedge_weight_weights,
+                                               bpt_linkage_algorithm algorithm = bpt_linkage_algorithm::heap) {
+        binary_partition_tree_internal::binary_partition_tree_average_linkage_weighting_functor<T>
+                weight_function(xedge_weights, xedge_weight_weights);
+        if (algorithm == bpt_linkage_algorithm::reciprocal_nearest_neighbours) {
+            return binary_partition_tree_reciprocal_nearest_neighbours(graph, xedge_weights,
+                                                                       std::move(weight_function));
+        }
+        return binary_partition_tree(graph, xedge_weights, std::move(weight_function));
     }
 
     /**
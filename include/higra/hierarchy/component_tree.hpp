@@ -15,10 +15,46 @@
 #include "higra/graph.hpp"
 #include "higra/sorting.hpp"
 #include "xtensor/xadapt.hpp"
+#include "xtensor/xview.hpp"
 
 namespace hg {
+
+    /**
+     * Algorithms available to compute the max tree and the min tree.
+     *
+     *  - sequential: union-find algorithm of Berger et al. on the whole graph;
+     *  - parallel: the tree of the vertex weights quantized on a small number of levels is first computed by
+     *    chunks of consecutive vertex indices, the trees of the chunks being computed in parallel and then merged
+     *    pairwise along the edges linking the chunks. Each node of this quantized tree is then refined in parallel
+     *    with the sequential algorithm (multi-threaded only if higra is built with TBB);
+     *  - automatic: parallel if higra is built with TBB and if the graph has at least
+     *    component_tree_internal::parallel_component_tree_threshold vertices, sequential otherwise.
+     *
+     * All algorithms produce exactly the same result.
+     */
+    enum class component_tree_algorithm {
+        automatic,
+        sequential,
+        parallel
+    };
+
     namespace component_tree_internal {
 
+        /**
+         * Minimum number of vertices for which component_tree_algorithm::automatic selects the parallel algorithm.
+         */
+        const index_t parallel_component_tree_threshold = 1 << 20;
+
+        /**
+         * Number of vertices of the chunks processed independently by the parallel algorithm.
+         */
+        const index_t parallel_component_tree_chunk_size = 1 << 16;
+
+        /**
+         * Number of quantization bands of the vertex weights used by the parallel algorithm.
+         */
+        const index_t parallel_component_tree_num_bands = 256;
+
         /**
          * Generic pre-tree construction from ordered vertex values
          *
@@ -82,6 +118,414 @@ namespace hg {
             }
         }
 
+        /**
+         * Level root of the node containing the vertex x in a canonized parent relation where the parent of a
+         * root is invalid_index: the level root of a node is the canonical element of the node (a node
+         * may temporarily have several canonical elements chained together during the merges done by
+         * connect_branches). Paths are compressed.
+         *
+         * @tparam T1
+         * @tparam T2
+         * @param x a vertex or invalid_index
+         * @param parents canonized parent relation (modified in place)
+         * @param vertex_weights vertex weights
+         * @return
+         */
+        template<typename T1, typename T2>
+        index_t level_root(index_t x, T1 &parents, const T2 &vertex_weights) {
+            if (x == invalid_index) {
+                return invalid_index;
+            }
+            auto r = x;
+            while (parents[r] != invalid_index && vertex_weights[parents[r]] == vertex_weights[r]) {
+                r = parents[r];
+            }
+            while (x != r) {
+                auto next = parents[x];
+                parents[x] = r;
+                x = next;
+            }
+            return r;
+        }
+
+        /**
+         * Merge of two branches of a canonized parent relation along an edge {x, y}, ranks giving the position
+         * of each vertex in the sorted vertex indices (the parent of a root is invalid_index).
+         *
+         * The ancestor nodes of x and of y are interleaved by decreasing levels and the nodes of same level are
+         * merged, the canonical element of a merged node being its element of smallest rank, see:
+         *
+         *  M. H. F. Wilkinson, H. Gao, W. H. Hesselink, J. E. Jonker and A. Meijster, "Concurrent Computation of
+         *  Attribute Filters on Shared Memory Parallel Machines," IEEE TPAMI, vol. 30, no. 10, pp. 1800-1813, 2008.
+         *
+         * @param x a vertex
+         * @param y a vertex
+         * @param parents canonized parent relation (modified in place)
+         * @param vertex_weights vertex weights
+         * @param ranks rank of each vertex
+         */
+        template<typename T1, typename T2, typename T3>
+        void connect_branches(index_t x, index_t y, T1 &parents, const T2 &vertex_weights, const T3 &ranks) {
+            x = level_root(x, parents, vertex_weights);
+            y = level_root(y, parents, vertex_weights);
+            if (ranks[x] < ranks[y]) {
+                std::swap(x, y);
+            }
+            // ranks are consistent with levels: vertex_weights[x] "is above or equal to" vertex_weights[y]
+            while (y != invalid_index && x != y) {
+                auto z = level_root(parents[x], parents, vertex_weights);
+                if (z != invalid_index && (ranks[z] > ranks[y] || vertex_weights[z] == vertex_weights[y])) {
+                    x = z;
+                } else {
+                    if (vertex_weights[x] == vertex_weights[y] && ranks[x] < ranks[y]) {
+                        std::swap(x, y);
+                        z = level_root(parents[x], parents, vertex_weights);
+                    }
+                    parents[x] = y;
+                    x = y;
+                    y = z;
+                }
+            }
+        }
+
+        /**
+         * Canonized parent relation computed by chunks: gives exactly the same result as pre_tree_construction
+         * followed by canonize_tree.
+         *
+         * The vertices are divided into chunks of chunk_size consecutive vertices. The canonized parent relation of
+         * each chunk is computed in parallel with the sequential algorithm. Chunks are then merged by pairs of groups
+         * of 2^l chunks at level l, the merges of a same level being done in parallel, by connecting the branches of
+         * the extremities of the edges linking the two groups. Merges follow the canonical elements of the nodes:
+         * the length of a branch is bounded by the number of distinct vertex weights.
+         *
+         * @tparam graph_t
+         * @tparam T1
+         * @tparam T2
+         * @tparam T3
+         * @param graph
+         * @param vertex_weights
+         * @param sorted_vertex_indices
+         * @param ranks position of each vertex in sorted_vertex_indices
+         * @param chunk_size
+         * @return
+         */
+        template<typename graph_t, typename T1, typename T2, typename T3>
+        auto chunked_canonized_tree_construction(const graph_t &graph,
+                                                 const T1 &vertex_weights,
+                                                 const T2 &sorted_vertex_indices,
+                                                 const T3 &ranks,
+                                                 index_t chunk_size) {
+            const index_t nbe = num_vertices(graph);
+            const index_t num_chunks = (std::max)((nbe + chunk_size - 1) / chunk_size, (index_t) 1);
+            index_t num_levels = 1;
+            while (((index_t) 1 << (num_levels - 1)) < num_chunks) {
+                num_levels++;
+            }
+
+            array_1d<index_t> parent = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<index_t> representing = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<bool> processed({(size_t) nbe}, false);
+            union_find uf(nbe);
+
+            // edges linking a chunk c to a chunk of greater index, bucketed by the level of the merge that
+            // processes them: cross_edges[c * num_levels + l]
+            std::vector<std::vector<std::pair<index_t, index_t>>> cross_edges(num_chunks * num_levels);
+
+            // sorted vertex indices of each chunk: stable counting sort of the sorted vertex indices by chunk
+            // (chunk c contains the vertices [c * chunk_size, (c + 1) * chunk_size[)
+            array_1d<index_t> chunk_sorted_vertices = array_1d<index_t>::from_shape({(size_t) nbe});
+            {
+                std::vector<index_t> positions(num_chunks);
+                for (index_t c = 0; c < num_chunks; c++) {
+                    positions[c] = c * chunk_size;
+                }
+                for (index_t i = 0; i < nbe; i++) {
+                    index_t v = sorted_vertex_indices[i];
+                    chunk_sorted_vertices(positions[v / chunk_size]++) = v;
+                }
+            }
+
+            // sequential algorithm on each chunk: each chunk only accesses its own vertices
+            parfor(0, num_chunks, [&](index_t c) {
+                const index_t start = c * chunk_size;
+                const index_t end = (std::min)(start + chunk_size, nbe);
+                auto chunk_vertices = xt::view(chunk_sorted_vertices, xt::range(start, end));
+
+                for (index_t k = end - start - 1; k >= 0; k--) {
+                    auto current_vertex = chunk_vertices(k);
+                    parent(current_vertex) = current_vertex;
+                    representing(current_vertex) = current_vertex;
+                    processed(current_vertex) = true;
+                    auto current_vertex_reprez = current_vertex;
+                    for (auto n: adjacent_vertex_iterator(current_vertex, graph)) {
+                        index_t cn = (index_t) n / chunk_size;
+                        if (cn == c) {
+                            if (processed(n)) {
+                                auto neighbor_component = uf.find(n);
+                                if (neighbor_component != current_vertex_reprez) {
+                                    parent[representing[neighbor_component]] = current_vertex;
+                                    current_vertex_reprez = uf.link(neighbor_component, current_vertex_reprez);
+                                    representing(current_vertex_reprez) = current_vertex;
+                                }
+                            }
+                        } else if (cn > c) {
+                            index_t level = 0;
+                            for (index_t d = c ^ cn; d != 0; d >>= 1) {
+                                level++;
+                            }
+                            cross_edges[c * num_levels + level].emplace_back(current_vertex, n);
+                        }
+                    }
+                }
+
+                canonize_tree(parent, vertex_weights, chunk_vertices);
+                for (auto v: chunk_vertices) {
+                    if (parent(v) == v) {
+                        parent(v) = invalid_index;
+                    }
+                }
+            });
+
+            // pairwise merges of groups of chunks
+            for (index_t level = 1; level < num_levels; level++) {
+                const index_t group_size = (index_t) 1 << level;
+                const index_t num_groups = (num_chunks + group_size - 1) / group_size;
+                parfor(0, num_groups, [&](index_t g) {
+                    for (index_t c = g * group_size; c < (std::min)((g + 1) * group_size, num_chunks); c++) {
+                        for (const auto &e: cross_edges[c * num_levels + level]) {
+                            connect_branches(e.first, e.second, parent, vertex_weights, ranks);
+                        }
+                    }
+                });
+            }
+
+            // flatten the chains of canonical elements created by the merges: the level roots are computed first,
+            // without modifying the parent relation, so that all vertices can be processed in parallel
+            array_1d<index_t> roots = array_1d<index_t>::from_shape({(size_t) nbe});
+            parfor(0, nbe, [&](index_t i) {
+                auto r = i;
+                while (parent(r) != invalid_index && vertex_weights[parent(r)] == vertex_weights[r]) {
+                    r = parent(r);
+                }
+                roots(i) = r;
+            });
+            array_1d<index_t> canonized_parent = array_1d<index_t>::from_shape({(size_t) nbe});
+            parfor(0, nbe, [&](index_t i) {
+                if (roots(i) != i) {
+                    canonized_parent(i) = roots(i);
+                } else {
+                    canonized_parent(i) = (parent(i) == invalid_index) ? i : roots(parent(i));
+                }
+            });
+            return canonized_parent;
+        }
+
+        /**
+         * Parallel computation of the canonized parent relation: gives exactly the same result as
+         * pre_tree_construction followed by canonize_tree.
+         *
+         * The merges of chunks done by chunked_canonized_tree_construction follow branches whose length is
+         * bounded by the number of distinct vertex weights: this is inefficient for high dynamic range weights.
+         * The vertex weights are thus first quantized in num_bands bands containing approximately the same number
+         * of vertices (vertices of equal weights being in the same band) and the tree of the quantized weights is
+         * computed by chunks. Each node of this quantized tree is then refined independently, in parallel, with the
+         * sequential algorithm applied on the vertices of the node, each child of the node being contracted into
+         * a single vertex, see:
+         *
+         *  U. Moschini, A. Meijster and M. H. F. Wilkinson, "A Hybrid Shared-Memory Parallel Max-Tree Algorithm
+         *  for Extreme Dynamic-Range Images," IEEE TPAMI, vol. 40, no. 3, pp. 513-526, 2018.
+         *
+         * @tparam graph_t
+         * @tparam T
+         * @tparam E
+         * @param graph
+         * @param vertex_weights
+         * @param sorted_vertex_indices
+         * @param chunk_size number of vertices of the chunks used to compute the quantized tree
+         * @param num_bands number of quantization bands
+         * @return
+         */
+        template<typename graph_t, typename T, typename E>
+        auto canonized_tree_construction_parallel(const graph_t &graph,
+                                                  const T &vertex_weights,
+                                                  const E &sorted_vertex_indices,
+                                                  index_t chunk_size = parallel_component_tree_chunk_size,
+                                                  index_t num_bands = parallel_component_tree_num_bands) {
+            const index_t nbe = num_vertices(graph);
+
+            array_1d<index_t> ranks = array_1d<index_t>::from_shape({(size_t) nbe});
+            parfor(0, nbe, [&ranks, &sorted_vertex_indices](index_t i) {
+                ranks[sorted_vertex_indices[i]] = i;
+            });
+
+            // quantization: the band only changes between two different weights, the vertices of rank in
+            // [band_start[b], band_start[b + 1][ are in the band b
+            array_1d<index_t> bands = array_1d<index_t>::from_shape({(size_t) nbe});
+            std::vector<index_t> band_start(num_bands + 1, nbe);
+            {
+                const index_t band_size = (std::max)((nbe + num_bands - 1) / num_bands, (index_t) 1);
+                index_t band = 0;
+                band_start[0] = 0;
+                for (index_t i = 0; i < nbe; i++) {
+                    auto v = sorted_vertex_indices[i];
+                    if (i > 0 && vertex_weights[v] != vertex_weights[sorted_vertex_indices[i - 1]] &&
+                        i / band_size != band) {
+                        for (index_t b = band + 1; b <= i / band_size; b++) {
+                            band_start[b] = i;
+                        }
+                        band = i / band_size;
+                    }
+                    bands(v) = band;
+                }
+            }
+
+            // quantized tree: the canonical element of a node of the quantized tree is its vertex of smallest rank,
+            // the parent of a canonical element is the canonical element of the parent node
+            auto quantized_parent = chunked_canonized_tree_construction(graph, bands, sorted_vertex_indices, ranks,
+                                                                        chunk_size);
+            auto quantized_node = [&quantized_parent, &bands](index_t v) {
+                auto p = quantized_parent(v);
+                return (bands(p) != bands(v)) ? v : p;
+            };
+
+            // vertices of each quantized node by increasing rank: node_vertices[node_start(c):node_end(c)]
+            // for the canonical element c of the node
+            std::vector<index_t> nodes;
+            array_1d<index_t> node_start = xt::zeros<index_t>({(size_t) nbe});
+            array_1d<index_t> node_end = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<index_t> node_vertices = array_1d<index_t>::from_shape({(size_t) nbe});
+            for (index_t i = 0; i < nbe; i++) {
+                auto v = sorted_vertex_indices[i];
+                auto c = quantized_node(v);
+                if (c == v) {
+                    nodes.push_back(c);
+                }
+                node_start(c)++;
+            }
+            {
+                index_t offset = 0;
+                for (auto c: nodes) {
+                    auto size = node_start(c);
+                    node_start(c) = offset;
+                    node_end(c) = offset;
+                    offset += size;
+                }
+            }
+            for (index_t i = 0; i < nbe; i++) {
+                auto v = sorted_vertex_indices[i];
+                node_vertices(node_end(quantized_node(v))++) = v;
+            }
+
+            // refinement of each quantized node with the sequential algorithm, each child of the node being
+            // contracted into its canonical element. The nodes are refined band by band, from the highest band to
+            // the lowest one, the nodes of a same band being disjoint. Once a node has been refined, the sets of its
+            // children are merged into its own set in subtree_root which then contains all the vertices of the
+            // node and of its descendants (the root of the set being the canonical element of the node).
+            //
+            // The working arrays are indexed by vertices: a child only uses the entries of its canonical element
+            // whose own refinement is already done. The pre-tree is directly stored and canonized in
+            // canonized_parent.
+            array_1d<index_t> canonized_parent = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<index_t> representing = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<index_t> uf_parent = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<index_t> uf_rank = array_1d<index_t>::from_shape({(size_t) nbe});
+            array_1d<index_t> child_of({(size_t) nbe}, invalid_index);
+            array_1d<index_t> subtree_root = array_1d<index_t>::from_shape({(size_t) nbe});
+            parfor(0, nbe, [&](index_t i) {
+                subtree_root(i) = quantized_node(i);
+            });
+
+            auto find = [](index_t x, array_1d<index_t> &parents) {
+                auto r = x;
+                while (parents(r) != r) {
+                    r = parents(r);
+                }
+                while (parents(x) != r) {
+                    auto next = parents(x);
+                    parents(x) = r;
+                    x = next;
+                }
+                return r;
+            };
+            auto make_set = [&](index_t x) {
+                canonized_parent(x) = x;
+                representing(x) = x;
+                uf_parent(x) = x;
+                uf_rank(x) = 0;
+            };
+
+            auto refine_node = [&](index_t k) {
+                const auto c = nodes[k];
+                const auto start = node_start(c);
+                const auto end = node_end(c);
+                // vertices of rank greater than or equal to band_end belong to the children of the node
+                const auto band_end = band_start[bands(c) + 1];
+                std::vector<index_t> children;
+
+                for (index_t i = end - 1; i >= start; i--) {
+                    auto current_vertex = node_vertices(i);
+                    auto current_rank = ranks(current_vertex);
+                    make_set(current_vertex);
+                    auto current_vertex_reprez = current_vertex;
+                    for (auto n: adjacent_vertex_iterator(current_vertex, graph)) {
+                        auto neighbor_rank = ranks(n);
+                        if (neighbor_rank <= current_rank) {
+                            continue;
+                        }
+                        index_t element = n;
+                        if (neighbor_rank >= band_end) {
+                            // a vertex of a child: children are processed first
+                            element = find(n, subtree_root);
+                            if (child_of(element) != c) {
+                                child_of(element) = c;
+                                children.push_back(element);
+                                make_set(element);
+                            }
+                        }
+                        auto neighbor_component = find(element, uf_parent);
+                        if (neighbor_component != current_vertex_reprez) {
+                            canonized_parent(representing(neighbor_component)) = current_vertex;
+                            // union by rank
+                            if (uf_rank(neighbor_component) > uf_rank(current_vertex_reprez)) {
+                                std::swap(neighbor_component, current_vertex_reprez);
+                            } else if (uf_rank(neighbor_component) == uf_rank(current_vertex_reprez)) {
+                                uf_rank(current_vertex_reprez)++;
+                            }
+                            uf_parent(neighbor_component) = current_vertex_reprez;
+                            representing(current_vertex_reprez) = current_vertex;
+                        }
+                    }
+                }
+
+                // canonization by increasing rank: the parent of any element is a vertex of the node
+                auto canonize = [&](index_t e) {
+                    auto par = canonized_parent(e);
+                    if (vertex_weights[canonized_parent(par)] == vertex_weights[par]) {
+                        canonized_parent(e) = canonized_parent(par);
+                    }
+                };
+                for (index_t i = start; i < end; i++) {
+                    canonize(node_vertices(i));
+                }
+                for (auto child: children) {
+                    canonize(child);
+                    subtree_root(child) = c;
+                }
+                // c is the root of the refined node: its parent is set by the refinement of the parent node
+            };
+
+            // nodes are sorted by increasing band
+            for (index_t end = (index_t) nodes.size(); end > 0;) {
+                index_t begin = end - 1;
+                while (begin > 0 && bands(nodes[begin - 1]) == bands(nodes[end - 1])) {
+                    begin--;
+                }
+                parfor(begin, end, refine_node);
+                end = begin;
+            }
+            return canonized_parent;
+        }
+
         /**
          * Expand a canonized parent relation to a regular parent relation (each node is represented individually)
          * @tparam T1
@@ -127,9 +571,25 @@ namespace hg {
 
         template<typename graph_t, typename T1, typename T2>
         auto
-        tree_from_sorted_vertices(const graph_t &graph, const T1 &vertex_weights, const T2 &sorted_vertex_indices) {
-            auto parents = pre_tree_construction(graph, sorted_vertex_indices);
-            canonize_tree(parents, vertex_weights, sorted_vertex_indices);
+        tree_from_sorted_vertices(const graph_t &graph,
+                                  const T1 &vertex_weights,
+                                  const T2 &sorted_vertex_indices,
+                                  component_tree_algorithm algorithm = component_tree_algorithm::sequential) {
+            if (algorithm == component_tree_algorithm::automatic) {
+#ifdef HG_USE_TBB
+                algorithm = ((index_t) num_vertices(graph) >= parallel_component_tree_threshold) ?
+                            component_tree_algorithm::parallel : component_tree_algorithm::sequential;
+#else
+                algorithm = component_tree_algorithm::sequential;
+#endif
+            }
+            array_1d<index_t> parents;
+            if (algorithm == component_tree_algorithm::parallel) {
+                parents = canonized_tree_construction_parallel(graph, vertex_weights, sorted_vertex_indices);
+            } else {
+                parents = pre_tree_construction(graph, sorted_vertex_indices);
+                canonize_tree(parents, vertex_weights, sorted_vertex_indices);
+            }
             auto res = expand_canonized_parent_relation(parents, vertex_weights, sorted_vertex_indices);
             array_1d<typename T1::value_type> altitudes = xt::adapt(res.second, {res.second.size()});
             return make_node_weighted_tree(
@@ -154,23 +614,28 @@ namespace hg {
      * Component Tree Computation with Application to Pattern Recognition in Astronomical Imaging,"
      * IEEE ICIP 2007.
      *
+     * The tree can be computed either with the sequential algorithm of [3] or with a parallel algorithm
+     * (see component_tree_algorithm): the result does not depend on this choice.
+     *
      * @tparam graph_t
      * @tparam T
      * @param graph input graph
      * @param vertex_weights graph vertex weights
+     * @param algorithm algorithm used to compute the tree
      * @return a node weighted tree
      */
     template<typename graph_t, typename T>
-    auto component_tree_max_tree(const graph_t &graph, const xt::xexpression<T> &xvertex_weights) {
+    auto component_tree_max_tree(const graph_t &graph,
+                                 const xt::xexpression<T> &xvertex_weights,
+                                 component_tree_algorithm algorithm = component_tree_algorithm::automatic) {
         HG_TRACE();
         auto &vertex_weights = xvertex_weights.derived_cast();
         hg_assert_vertex_weights(graph, vertex_weights);
         hg_assert_1d_array(vertex_weights);
 
-        array_1d<index_t> sorted_vertex_indices = xt::arange(num_vertices(graph));
-        stable_sort(sorted_vertex_indices.begin(), sorted_vertex_indices.end(),
-                    [&vertex_weights](index_t i, index_t j) { return vertex_weights[i] < vertex_weights[j]; });
-        return component_tree_internal::tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices);
+        array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights);
+        return component_tree_internal::tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices,
+                                                                  algorithm);
     }
 
     /**
@@ -189,23 +654,28 @@ namespace hg {
     * Component Tree Computation with Application to Pattern Recognition in Astronomical Imaging,"
     * IEEE ICIP 2007.
     *
+    * The tree can be computed either with the sequential algorithm of [3] or with a parallel algorithm
+    * (see component_tree_algorithm): the result does not depend on this choice.
+    *
     * @tparam graph_t
     * @tparam T
     * @param graph input graph
     * @param vertex_weights graph vertex weights
+    * @param algorithm algorithm used to compute the tree
     * @return a node weighted tree
     */
     template<typename graph_t, typename T>
-    auto component_tree_min_tree(const graph_t &graph, const xt::xexpression<T> &xvertex_weights) {
+    auto component_tree_min_tree(const graph_t &graph,
+                                 const xt::xexpression<T> &xvertex_weights,
+                                 component_tree_algorithm algorithm = component_tree_algorithm::automatic) {
         HG_TRACE();
         auto &vertex_weights = xvertex_weights.derived_cast();
         hg_assert_vertex_weights(graph, vertex_weights);
         hg_assert_1d_array(vertex_weights);
 
-        array_1d<index_t> sorted_vertex_indices = xt::arange(num_vertices(graph));
-        stable_sort(sorted_vertex_indices.begin(), sorted_vertex_indices.end(),
-                    [&vertex_weights](index_t i, index_t j) { return vertex_weights[i] > vertex_weights[j]; });
-        return component_tree_internal::tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices);
+        array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights, true);
+        return component_tree_internal::tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices,
+                                                                  algorithm);
     }
 
 }
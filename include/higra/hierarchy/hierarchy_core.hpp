@@ -21,6 +21,8 @@
 #include <utility>
 #include <tuple>
 #include <queue>
+#include <atomic>
+#include <numeric>
 
 namespace hg {
 
@@ -53,6 +55,334 @@ namespace hg {
                                                                      std::forward<array_1d<index_t> >(mst_edge_map)};
     }
 
+    /**
+     * A graph given as a plain list of edges, without any adjacency information: the i-th edge links the
+     * vertices sources(i) and targets(i).
+     */
+    struct edge_list {
+        array_1d<index_t> sources;
+        array_1d<index_t> targets;
+    };
+
+    /**
+     * Algorithms available to compute the minimum spanning tree underlying a canonical binary partition tree.
+     *
+     *  - kruskal: sequential Kruskal algorithm on all the edges of the graph sorted by weight;
+     *  - boruvka: parallel Boruvka algorithm (multi-threaded if higra is built with TBB) followed by a Kruskal sweep
+     *    over the edges of the minimum spanning tree only;
+     *  - automatic: boruvka if higra is built with TBB and if the graph has at least
+     *    hierarchy_core_internal::bpt_canonical_boruvka_threshold edges, kruskal otherwise.
+     *
+     * All algorithms produce exactly the same result.
+     */
+    enum class bpt_algorithm {
+        automatic,
+        kruskal,
+        boruvka
+    };
+
+    namespace hierarchy_core_internal {
+
+        /**
+         * Minimum number of edges for which bpt_algorithm::automatic selects the Boruvka algorithm.
+         */
+        const index_t bpt_canonical_boruvka_threshold = 1 << 20;
+
+        /**
+         * Strict total order on edge indices: edges are compared by weights and ties are broken with edge indices.
+         * This is the order in which the edges are processed by a Kruskal algorithm relying on a stable sort.
+         *
+         * @tparam T type of edge weights
+         */
+        template<typename T>
+        struct edge_weight_index_less {
+            const T &edge_weights;
+
+            bool operator()(index_t i, index_t j) const {
+                return edge_weights[i] < edge_weights[j] || (edge_weights[i] == edge_weights[j] && i < j);
+            }
+        };
+
+        /**
+         * Parallel filter of an array of indices: returns the elements i of values such that predicate(i) is true
+         * (the order of the elements is preserved).
+         *
+         * @tparam predicate_t
+         * @param values input indices
+         * @param predicate a thread safe predicate
+         * @return array of indices
+         */
+        template<typename predicate_t>
+        array_1d<index_t> parallel_filter(const array_1d<index_t> &values, const predicate_t &predicate) {
+            const index_t block_size = 1 << 14;
+            const index_t num_values = values.size();
+            const index_t num_blocks = (num_values + block_size - 1) / block_size;
+
+            std::vector<index_t> offsets(num_blocks + 1, 0);
+            parfor(0, num_blocks, [&values, &predicate, &offsets, block_size, num_values](index_t b) {
+                index_t count = 0;
+                for (index_t i = b * block_size; i < std::min((b + 1) * block_size, num_values); i++) {
+                    if (predicate(values(i))) {
+                        count++;
+                    }
+                }
+                offsets[b + 1] = count;
+            });
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            array_1d<index_t> result = array_1d<index_t>::from_shape({(size_t) offsets[num_blocks]});
+            parfor(0, num_blocks, [&values, &predicate, &offsets, &result, block_size, num_values](index_t b) {
+                index_t pos = offsets[b];
+                for (index_t i = b * block_size; i < std::min((b + 1) * block_size, num_values); i++) {
+                    if (predicate(values(i))) {
+                        result(pos++) = values(i);
+                    }
+                }
+            });
+            return result;
+        }
+
+        /**
+         * Computes the edges of the minimum spanning tree of the given edge weighted graph with Boruvka's algorithm.
+         *
+         * Edges are totally ordered with edge_weight_index_less, the minimum spanning tree is thus unique and it
+         * is equal to the one found by a Kruskal algorithm relying on a stable sort.
+         *
+         * At each round, the lightest edge leaving each component is found in parallel, the selected edges are
+         * then merged sequentially with a union find (the number of components is at least halved at each round),
+         * and finally, the edges which are now inside a component are removed in parallel.
+         *
+         * @tparam graph_t
+         * @tparam T
+         * @param graph input graph (must be connected)
+         * @param edge_weights input edge weights
+         * @return the indices of the edges of the minimum spanning tree in an arbitrary order
+         */
+        template<typename graph_t, typename T>
+        array_1d<index_t> minimum_spanning_tree_edges_boruvka(const graph_t &graph, const T &edge_weights) {
+            HG_TRACE();
+            const index_t num_v = num_vertices(graph);
+            const index_t num_e = num_edges(graph);
+            const index_t num_edge_mst = (num_v > 0) ? num_v - 1 : 0;
+            const edge_weight_index_less<T> less{edge_weights};
+
+            array_1d<index_t> sources = array_1d<index_t>::from_shape({(size_t) num_e});
+            array_1d<index_t> targets = array_1d<index_t>::from_shape({(size_t) num_e});
+            parfor(0, num_e, [&graph, &sources, &targets](index_t i) {
+                auto e = edge_from_index(i, graph);
+                sources(i) = source(e, graph);
+                targets(i) = target(e, graph);
+            });
+
+            // a component is identified by the root of its vertices in the union find
+            array_1d<index_t> component = xt::arange<index_t>(num_v);
+            array_1d<index_t> new_component = array_1d<index_t>::from_shape({(size_t) num_v});
+            std::vector<index_t> components(num_v);
+            std::iota(components.begin(), components.end(), 0);
+            std::vector<index_t> next_components;
+
+            // lightest edge leaving each component
+            std::vector<std::atomic<index_t>> best_edge(num_v);
+
+            array_1d<index_t> mst_edges = array_1d<index_t>::from_shape({(size_t) num_edge_mst});
+            index_t num_edge_found = 0;
+            union_find uf(num_v);
+
+            auto is_external = [&component, &sources, &targets](index_t ei) {
+                return component(sources(ei)) != component(targets(ei));
+            };
+            array_1d<index_t> active_edges = parallel_filter(xt::arange<index_t>(num_e), is_external);
+
+            while (components.size() > 1 && active_edges.size() > 0) {
+                parfor(0, components.size(), [&best_edge, &components](index_t i) {
+                    best_edge[components[i]].store(invalid_index, std::memory_order_relaxed);
+                });
+
+                parfor(0, active_edges.size(), [&](index_t i) {
+                    auto ei = active_edges(i);
+                    for (auto c: {component(sources(ei)), component(targets(ei))}) {
+                        auto &best = best_edge[c];
+                        index_t current = best.load(std::memory_order_relaxed);
+                        while ((current == invalid_index || less(ei, current)) &&
+                               !best.compare_exchange_weak(current, ei, std::memory_order_relaxed)) {}
+                    }
+                });
+
+                for (auto c: components) {
+                    auto ei = best_edge[c].load(std::memory_order_relaxed);
+                    if (ei != invalid_index) {
+                        auto c1 = uf.find(sources(ei));
+                        auto c2 = uf.find(targets(ei));
+                        if (c1 != c2) {
+                            uf.link(c1, c2);
+                            mst_edges(num_edge_found++) = ei;
+                        }
+                    }
+                }
+
+                next_components.clear();
+                for (auto c: components) {
+                    new_component(c) = uf.find(c);
+                    if (new_component(c) == c) {
+                        next_components.push_back(c);
+                    }
+                }
+                components.swap(next_components);
+
+                parfor(0, num_v, [&component, &new_component](index_t i) {
+                    component(i) = new_component(component(i));
+                });
+
+                active_edges = parallel_filter(active_edges, is_external);
+            }
+            hg_assert(num_edge_found == num_edge_mst, "Input graph must be connected.");
+
+            return mst_edges;
+        }
+    }
+
+    namespace hierarchy_core_internal {
+
+        /**
+         * Kruskal sweep of the canonical binary partition tree: the candidate edges are processed in the given
+         * order and an edge is added to the minimum spanning tree if it links two different components.
+         *
+         * @tparam T type of edge weights
+         * @tparam edge_fun_t
+         * @param num_points number of vertices of the graph
+         * @param sorted_edges_indices candidate edges indices sorted by weights
+         * @param edge_weights edge weights
+         * @param edge_fun function that gives the pair (source, target) of an edge index
+         * @return a node_weighted_tree_and_mst whose mst is an edge_list
+         */
+        template<typename T, typename edge_fun_t>
+        auto bpt_canonical_kruskal_sweep(index_t num_points,
+                                         const array_1d<index_t> &sorted_edges_indices,
+                                         const T &edge_weights,
+                                         const edge_fun_t &edge_fun) {
+            index_t num_edge_mst = num_points - 1;
+            edge_list mst{array_1d<index_t>::from_shape({(size_t) num_edge_mst}),
+                          array_1d<index_t>::from_shape({(size_t) num_edge_mst})};
+            array_1d<index_t> mst_edge_map = array_1d<index_t>::from_shape({(size_t) num_edge_mst});
+
+            union_find uf(num_points);
+
+            array_1d<index_t> roots = xt::arange(num_points);
+            array_1d<index_t> parents = xt::arange(num_points * 2 - 1);
+
+            array_1d<typename T::value_type> levels = xt::zeros<typename T::value_type>({num_points * 2 - 1});
+
+            index_t num_nodes = num_points;
+            index_t num_edge_found = 0;
+            index_t i = 0;
+
+            while (num_edge_found < num_edge_mst && i < (index_t) sorted_edges_indices.size()) {
+                auto ei = sorted_edges_indices[i];
+                auto e = edge_fun(ei);
+                auto c1 = uf.find(e.first);
+                auto c2 = uf.find(e.second);
+                if (c1 != c2) {
+                    levels[num_nodes] = edge_weights[ei];
+                    parents[roots[c1]] = num_nodes;
+                    parents[roots[c2]] = num_nodes;
+                    auto newRoot = uf.link(c1, c2);
+                    roots[newRoot] = num_nodes;
+                    mst.sources(num_edge_found) = e.first;
+                    mst.targets(num_edge_found) = e.second;
+                    mst_edge_map(num_edge_found) = ei;
+                    num_nodes++;
+                    num_edge_found++;
+                }
+                i++;
+            }
+            hg_assert(num_edge_found == num_edge_mst, "Input graph must be connected.");
+
+            return make_node_weighted_tree_and_mst(
+                    tree(parents),
+                    std::move(levels),
+                    std::move(mst),
+                    std::move(mst_edge_map));
+        }
+    }
+
+    /**
+     * Compute the canonical binary partition tree (or binary partition tree by altitude ordering) of the given
+     * edge weighted graph. Same as bpt_canonical, except that the minimum spanning tree is returned as an edge_list:
+     * no adjacency information is built, which saves a lot of memory on large graphs (in particular with implicit
+     * graphs such as grid_graph_2d).
+     *
+     * The i-th edge of the minimum spanning tree corresponds to the edge mst_edge_map(i) of the input graph.
+     *
+     * @tparam graph_t
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param algorithm algorithm used to compute the minimum spanning tree
+     * @return a node_weighted_tree_and_mst whose mst is an edge_list
+     */
+    template<typename graph_t, typename T>
+    auto bpt_canonical_edge_list(const graph_t &graph,
+                                 const xt::xexpression<T> &xedge_weights,
+                                 bpt_algorithm algorithm = bpt_algorithm::automatic) {
+        HG_TRACE();
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(graph, edge_weights);
+        hg_assert_1d_array(edge_weights);
+
+        if (algorithm == bpt_algorithm::automatic) {
+#ifdef HG_USE_TBB
+            algorithm = ((index_t) num_edges(graph) >= hierarchy_core_internal::bpt_canonical_boruvka_threshold) ?
+                        bpt_algorithm::boruvka : bpt_algorithm::kruskal;
+#else
+            algorithm = bpt_algorithm::kruskal;
+#endif
+        }
+
+        // edges processed by the Kruskal sweep, sorted by weights (ties are broken by edge indices)
+        array_1d<index_t> sorted_edges_indices;
+        if (algorithm == bpt_algorithm::boruvka) {
+            sorted_edges_indices = hierarchy_core_internal::minimum_spanning_tree_edges_boruvka(graph, edge_weights);
+            hg::sort(sorted_edges_indices.begin(), sorted_edges_indices.end(),
+                     hierarchy_core_internal::edge_weight_index_less<std::decay_t<decltype(edge_weights)>>{edge_weights});
+        } else {
+            sorted_edges_indices = stable_arg_sort(edge_weights);
+        }
+
+        return hierarchy_core_internal::bpt_canonical_kruskal_sweep(
+                num_vertices(graph), sorted_edges_indices, edge_weights,
+                [&graph](index_t ei) {
+                    auto e = edge_from_index(ei, graph);
+                    return std::make_pair((index_t) source(e, graph), (index_t) target(e, graph));
+                });
+    };
+
+    /**
+     * Compute the canonical binary partition tree of a graph given as a list of edges (see edge_list).
+     *
+     * @tparam T
+     * @param num_vertices number of vertices of the graph
+     * @param edges edges of the graph
+     * @param xedge_weights edge weights
+     * @return a node_weighted_tree_and_mst whose mst is an edge_list
+     */
+    template<typename T>
+    auto bpt_canonical_edge_list(index_t num_vertices,
+                                 const edge_list &edges,
+                                 const xt::xexpression<T> &xedge_weights) {
+        HG_TRACE();
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_1d_array(edge_weights);
+        hg_assert(edges.sources.size() == edge_weights.size() && edges.targets.size() == edge_weights.size(),
+                  "Edge weights size does not match the number of edges.");
+
+        array_1d<index_t> sorted_edges_indices = stable_arg_sort(edge_weights);
+        return hierarchy_core_internal::bpt_canonical_kruskal_sweep(
+                num_vertices, sorted_edges_indices, edge_weights,
+                [&edges](index_t ei) {
+                    return std::make_pair(edges.sources(ei), edges.targets(ei));
+                });
+    };
+
     /**
      * Compute the canonical binary partition tree (or binary partition tree by altitude ordering) of the given
      * edge weighted graph.
@@ -65,65 +395,34 @@ namespace hg {
      * L. Najman, J. Cousty, B. Perret. Playing with Kruskal: algorithms for morphological trees in edge-weighted graphs.
      * In, 11th International Symposium on Mathematical Morphology, ISMM 2013, Uppsala, Sweden, Mai 2013.
      *
+     * The minimum spanning tree can either be computed with a sequential Kruskal algorithm or with a parallel
+     * Boruvka algorithm (see bpt_algorithm): the result does not depend on this choice. In particular, ties in edge
+     * weights are always broken with edge indices (as a stable sort of the edges would do).
+     *
+     * If the minimum spanning tree is not needed as an explicit graph, use bpt_canonical_edge_list.
+     *
      * @tparam graph_t
      * @tparam T
      * @param graph
      * @param xedge_weights
+     * @param algorithm algorithm used to compute the minimum spanning tree
      * @return
      */
     template<typename graph_t, typename T>
-    auto bpt_canonical(const graph_t &graph, const xt::xexpression<T> &xedge_weights) {
+    auto bpt_canonical(const graph_t &graph,
+                       const xt::xexpression<T> &xedge_weights,
+                       bpt_algorithm algorithm = bpt_algorithm::automatic) {
         HG_TRACE();
-        auto &edge_weights = xedge_weights.derived_cast();
-        hg_assert_edge_weights(graph, edge_weights);
-        hg_assert_1d_array(edge_weights);
+        auto res = bpt_canonical_edge_list(graph, xedge_weights, algorithm);
 
-        array_1d<index_t> sorted_edges_indices = xt::arange(num_edges(graph));
-        stable_sort(sorted_edges_indices.begin(), sorted_edges_indices.end(),
-                    [&edge_weights](index_t i, index_t j) { return edge_weights[i] < edge_weights[j]; });
-
-        auto num_points = num_vertices(graph);
-
-        auto num_edge_mst = num_points - 1;
-        ugraph mst(num_points);
-        array_1d<index_t> mst_edge_map = xt::empty<index_t>({num_edge_mst});
-
-        union_find uf(num_points);
-
-        array_1d<index_t> roots = xt::arange(num_points);
-        array_1d<index_t> parents = xt::arange(num_points * 2 - 1);
-
-        array_1d<typename T::value_type> levels = xt::zeros<typename T::value_type>({num_points * 2 - 1});
-
-        size_t num_nodes = num_points;
-        size_t num_edge_found = 0;
-        index_t i = 0;
-
-        while (num_edge_found < num_edge_mst && i < (index_t) sorted_edges_indices.size()) {
-            auto ei = sorted_edges_indices[i];
-            auto e = edge_from_index(ei, graph);
-            auto c1 = uf.find(source(e, graph));
-            auto c2 = uf.find(target(e, graph));
-            if (c1 != c2) {
-                levels[num_nodes] = edge_weights[ei];
-                parents[roots[c1]] = num_nodes;
-                parents[roots[c2]] = num_nodes;
-                auto newRoot = uf.link(c1, c2);
-                roots[newRoot] = num_nodes;
-                mst.add_edge(e);
-                mst_edge_map(num_edge_found) = ei;
-                num_nodes++;
-                num_edge_found++;
-            }
-            i++;
-        }
-        hg_assert(num_edge_found == num_edge_mst, "Input graph must be connected.");
+        ugraph mst(num_vertices(graph));
+        add_edges(res.mst.sources, res.mst.targets, mst);
 
         return make_node_weighted_tree_and_mst(
-                tree(parents),
-                std::move(levels),
+                std::move(res.tree),
+                std::move(res.altitudes),
                 std::move(mst),
-                std::move(mst_edge_map));
+                std::move(res.mst_edge_map));
     };
 
 
@@ -332,6 +631,8 @@ namespace hg {
      * The weight of an edge {x, y} is the altitude of the lowest common ancestor of x and y in the
      * hierarchy.
      *
+     * The lowest common ancestor preprocessing of the tree is stored in the global result cache (see cached_lca_fast).
+     *
      * @tparam graph_t Input graph type
      * @tparam tree_t Input tree type
      * @tparam T xepression derived type of input altitudes
@@ -345,8 +646,8 @@ namespace hg {
                       const tree_t &tree,
                       const xt::xexpression<T> &xaltitudes) {
         auto &altitudes = xaltitudes.derived_cast();
-        lca_fast lca(tree);
-        auto lca_edges = lca.lca(edge_iterator(graph));
+        auto lca = cached_lca_fast(tree);
+        auto lca_edges = lca->lca(edge_iterator(graph));
         return xt::eval(xt::index_view(altitudes, lca_edges));
     }
 
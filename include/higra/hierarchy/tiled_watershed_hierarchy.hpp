@@ -0,0 +1,253 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "watershed_hierarchy.hpp"
+#include "../image/graph_image.hpp"
+#include "../io/tile_reader.hpp"
+#include "../structure/unionfind.hpp"
+#include "../sorting.hpp"
+#include "xtensor/xadapt.hpp"
+#include <vector>
+
+namespace hg {
+
+    namespace tiled_watershed_hierarchy_internal {
+
+        /**
+         * Candidate edges of the minimum spanning tree found in a tile: the edges of the minimum spanning forest of
+         * the tile and the edges linking the tile to its right and bottom neighbour tiles.
+         */
+        template<typename value_type>
+        struct tile_candidate_edges {
+            std::vector<index_t> edges;
+            std::vector<value_type> weights;
+        };
+
+        /**
+         * Candidate edges of the tile of origin (y0, x0) and of size height x width. Edges are identified by
+         * their index in the 4-adjacency graph of the image.
+         *
+         * An edge of the tile that does not belong to the minimum spanning forest of the tile is the largest edge
+         * of a cycle (for the order on weights with ties broken by edge indices): it cannot belong to the
+         * minimum spanning tree of the image.
+         */
+        template<typename reader_t>
+        auto tile_minimum_spanning_forest(const reader_t &reader,
+                                          const grid_graph_2d &graph,
+                                          index_t y0, index_t x0,
+                                          index_t height, index_t width) {
+            using value_type = typename reader_t::value_type;
+            index_t image_height = graph.embedding().shape()[0];
+            index_t image_width = graph.embedding().shape()[1];
+
+            auto weights = reader.read_tile(y0, x0, height, width);
+            hg_assert(weights.dimension() == 3 &&
+                      (index_t) weights.shape()[0] == height &&
+                      (index_t) weights.shape()[1] == width &&
+                      weights.shape()[2] == 2,
+                      "Tile reader returned a tile of invalid shape.");
+
+            tile_candidate_edges<value_type> candidates;
+            std::vector<index_t> local_edges;
+            std::vector<std::pair<index_t, index_t>> local_extremities;
+            std::vector<value_type> local_weights;
+
+            // edges are enumerated by increasing index in the image graph
+            for (index_t i = 0; i < height; i++) {
+                for (index_t j = 0; j < width; j++) {
+                    for (index_t c = 0; c < 2; c++) { // c = 0: right neighbour, c = 1: bottom neighbour
+                        index_t ni = i + c;
+                        index_t nj = j + 1 - c;
+                        if (y0 + ni >= image_height || x0 + nj >= image_width) {
+                            continue;
+                        }
+                        index_t e = graph.edge_index(y0 + i, x0 + j, c);
+                        if (ni < height && nj < width) {
+                            local_edges.push_back(e);
+                            local_extremities.emplace_back(i * width + j, ni * width + nj);
+                            local_weights.push_back(weights(i, j, c));
+                        } else { // seam edge
+                            candidates.edges.push_back(e);
+                            candidates.weights.push_back(weights(i, j, c));
+                        }
+                    }
+                }
+            }
+
+            // Kruskal algorithm on the tile: the stable sort breaks ties with edge indices
+            auto sorted_edges = stable_arg_sort(xt::adapt(local_weights, {local_weights.size()}));
+            union_find uf(height * width);
+            index_t num_edge_found = 0;
+            for (index_t k = 0; k < (index_t) sorted_edges.size() && num_edge_found < height * width - 1; k++) {
+                auto ei = sorted_edges(k);
+                auto c1 = uf.find(local_extremities[ei].first);
+                auto c2 = uf.find(local_extremities[ei].second);
+                if (c1 != c2) {
+                    uf.link(c1, c2);
+                    candidates.edges.push_back(local_edges[ei]);
+                    candidates.weights.push_back(local_weights[ei]);
+                    num_edge_found++;
+                }
+            }
+            return candidates;
+        }
+    }
+
+    /**
+     * Canonical binary partition tree of the 4-adjacency graph of an image whose edge weights are read by tiles
+     * through the given tile reader (see tile readers in io/tile_reader.hpp).
+     *
+     * The minimum spanning forest of each tile is computed independently (and in parallel if higra is built with
+     * TBB), only one tile per thread being loaded in memory at any time. The edges of those forests together with
+     * the edges linking adjacent tiles contain the minimum spanning tree of the image: the canonical binary partition
+     * tree is then computed on this reduced set of edges.
+     *
+     * The result is exactly the same as the one of bpt_canonical on the graph returned by get_4_adjacency_graph
+     * with the same edge weights. In particular, the i-th edge of the minimum spanning tree corresponds to the edge
+     * mst_edge_map(i) of this graph.
+     *
+     * The memory used is linear with respect to the number of pixels (the result) plus the size of the tiles being
+     * processed: the edge weights of the whole image are never loaded.
+     *
+     * @tparam reader_t
+     * @param reader a tile reader
+     * @param tile_height height of the tiles
+     * @param tile_width width of the tiles
+     * @return a node_weighted_tree_and_mst whose mst is an edge_list
+     */
+    template<typename reader_t>
+    auto tiled_bpt_canonical(const reader_t &reader, index_t tile_height, index_t tile_width) {
+        HG_TRACE();
+        using value_type = typename reader_t::value_type;
+        hg_assert(tile_height > 0 && tile_width > 0, "Tile size must be positive.");
+
+        const auto &embedding = reader.embedding();
+        index_t height = embedding.shape()[0];
+        index_t width = embedding.shape()[1];
+        // implicit graph: only used to compute edge indices and extremities
+        auto graph = get_4_adjacency_grid_graph(embedding);
+
+        index_t num_tiles_y = (height + tile_height - 1) / tile_height;
+        index_t num_tiles_x = (width + tile_width - 1) / tile_width;
+        std::vector<tiled_watershed_hierarchy_internal::tile_candidate_edges<value_type>> tiles(
+                num_tiles_y * num_tiles_x);
+
+        parfor(0, num_tiles_y * num_tiles_x, [&](index_t t) {
+            index_t y0 = (t / num_tiles_x) * tile_height;
+            index_t x0 = (t % num_tiles_x) * tile_width;
+            tiles[t] = tiled_watershed_hierarchy_internal::tile_minimum_spanning_forest(
+                    reader, graph, y0, x0,
+                    (std::min)(tile_height, height - y0),
+                    (std::min)(tile_width, width - x0));
+        });
+
+        // merge the candidate edges of the tiles and sort them by edge index
+        index_t num_candidates = 0;
+        for (const auto &tile: tiles) {
+            num_candidates += (index_t) tile.edges.size();
+        }
+        array_1d<index_t> candidate_edges = array_1d<index_t>::from_shape({(size_t) num_candidates});
+        array_1d<value_type> candidate_weights = array_1d<value_type>::from_shape({(size_t) num_candidates});
+        {
+            index_t k = 0;
+            for (auto &tile: tiles) {
+                std::copy(tile.edges.begin(), tile.edges.end(), candidate_edges.begin() + k);
+                std::copy(tile.weights.begin(), tile.weights.end(), candidate_weights.begin() + k);
+                k += (index_t) tile.edges.size();
+                tile = {};
+            }
+        }
+        array_1d<index_t> order = xt::arange<index_t>(num_candidates);
+        hg::sort(order.begin(), order.end(),
+                 [&candidate_edges](index_t i, index_t j) { return candidate_edges(i) < candidate_edges(j); });
+
+        // edges of the candidate graph are ordered as in the image graph: ties in edge weights are broken
+        // in the same way by the Kruskal sweep
+        edge_list candidates{array_1d<index_t>::from_shape({(size_t) num_candidates}),
+                             array_1d<index_t>::from_shape({(size_t) num_candidates})};
+        array_1d<index_t> sorted_candidate_edges = array_1d<index_t>::from_shape({(size_t) num_candidates});
+        array_1d<value_type> sorted_candidate_weights = array_1d<value_type>::from_shape({(size_t) num_candidates});
+        parfor(0, num_candidates, [&](index_t i) {
+            auto ei = candidate_edges(order(i));
+            auto e = edge_from_index(ei, graph);
+            candidates.sources(i) = source(e, graph);
+            candidates.targets(i) = target(e, graph);
+            sorted_candidate_edges(i) = ei;
+            sorted_candidate_weights(i) = candidate_weights(order(i));
+        });
+
+        auto res = bpt_canonical_edge_list(height * width, candidates, sorted_candidate_weights);
+        auto &mst_edge_map = res.mst_edge_map;
+        for (index_t i = 0; i < (index_t) mst_edge_map.size(); i++) {
+            mst_edge_map(i) = sorted_candidate_edges(mst_edge_map(i));
+        }
+        return res;
+    };
+
+    /**
+     * Computes a hierarchical watershed for the given regional attribute on the 4-adjacency graph of an image whose
+     * edge weights are read by tiles through the given tile reader (see tiled_bpt_canonical).
+     *
+     * The result is exactly the same as the one of watershed_hierarchy_by_attribute on the graph returned by
+     * get_4_adjacency_graph with the same edge weights.
+     *
+     * @tparam reader_t
+     * @tparam F
+     * @param reader a tile reader
+     * @param tile_height height of the tiles
+     * @param tile_width width of the tiles
+     * @param attribute_functor function that computes the attribute value from a tree and its node altitudes
+     * @return a node_weighted_tree
+     */
+    template<typename reader_t, typename F>
+    auto tiled_watershed_hierarchy_by_attribute(const reader_t &reader,
+                                                index_t tile_height,
+                                                index_t tile_width,
+                                                const F &attribute_functor) {
+        auto bptc = tiled_bpt_canonical(reader, tile_height, tile_width);
+        return watershed_hierarchy_internal::watershed_hierarchy_from_bpt_canonical(
+                (index_t) reader.embedding().size(), bptc, attribute_functor);
+    };
+
+    template<typename reader_t>
+    auto tiled_watershed_hierarchy_by_area(const reader_t &reader,
+                                           index_t tile_height,
+                                           index_t tile_width) {
+        return tiled_watershed_hierarchy_by_attribute(
+                reader, tile_height, tile_width,
+                [](const tree &t, const auto &altitude) {
+                    return attribute_area(t);
+                });
+    };
+
+    template<typename reader_t>
+    auto tiled_watershed_hierarchy_by_volume(const reader_t &reader,
+                                             index_t tile_height,
+                                             index_t tile_width) {
+        return tiled_watershed_hierarchy_by_attribute(
+                reader, tile_height, tile_width,
+                [](const tree &t, const auto &altitude) {
+                    return attribute_volume(t, altitude, attribute_area(t));
+                });
+    };
+
+    template<typename reader_t>
+    auto tiled_watershed_hierarchy_by_dynamics(const reader_t &reader,
+                                               index_t tile_height,
+                                               index_t tile_width) {
+        return tiled_watershed_hierarchy_by_attribute(
+                reader, tile_height, tile_width,
+                [](const tree &t, const auto &altitude) {
+                    return attribute_dynamics(t, altitude, true);
+                });
+    };
+}
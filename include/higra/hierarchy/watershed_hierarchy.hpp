@@ -24,7 +24,7 @@ namespace hg {
                                    const T1 &altitude,
                                    const T2 &attribute) {
             using value_type = typename T2::value_type;
-            array_1d<value_type> result = xt::empty_like(attribute);
+            array_1d<value_type> result = array_1d<value_type>::from_shape(attribute.shape());
             for (auto n: leaves_iterator(tree)) {
                 result(n) = 0;
             }
@@ -42,6 +42,44 @@ namespace hg {
             result(root(tree)) = attribute(root(tree));
             return result;
         };
+
+        /**
+         * Hierarchical watershed for the given regional attribute computed from the canonical binary partition tree
+         * of the graph (see watershed_hierarchy_by_attribute).
+         *
+         * @tparam bptc_t
+         * @tparam F
+         * @param num_points number of vertices of the graph
+         * @param bptc canonical binary partition tree of the graph with its minimum spanning tree as an edge_list
+         * @param attribute_functor function that computes the attribute value from a tree and its node altitudes
+         * @return a node_weighted_tree
+         */
+        template<typename bptc_t, typename F>
+        auto watershed_hierarchy_from_bpt_canonical(index_t num_points,
+                                                    const bptc_t &bptc,
+                                                    const F &attribute_functor) {
+            auto &bpt = bptc.tree;
+            auto &altitude = bptc.altitudes;
+            auto &mst = bptc.mst;
+
+            auto bpt_attribute = attribute_functor(bpt, altitude);
+            auto corrected_attribute = correct_attribute_BPT(bpt, altitude, bpt_attribute);
+            auto persistence = accumulate_parallel(bpt, corrected_attribute, accumulator_min());
+            xt::view(persistence, xt::range(0, num_leaves(bpt))) = 0;
+
+            auto mst_edge_weights = xt::view(persistence, xt::range(num_leaves(bpt), num_vertices(bpt)));
+
+            auto bptc2 = bpt_canonical_edge_list(num_points, mst, mst_edge_weights);
+            auto &bpt2 = bptc2.tree;
+            auto &altitude2 = bptc2.altitudes;
+
+            auto canonical_tree = simplify_tree(bpt2, [&altitude2, &bpt2](index_t i) {
+                return altitude2(i) == altitude2(parent(i, bpt2));
+            });
+            auto canonical_altitude = xt::eval(xt::index_view(altitude2, canonical_tree.node_map));
+
+            return make_node_weighted_tree(std::move(canonical_tree.tree), std::move(canonical_altitude));
+        }
     }
 
     /**
@@ -75,28 +113,10 @@ namespace hg {
         hg_assert_edge_weights(graph, edge_weights);
         hg_assert_1d_array(edge_weights);
 
-        auto bptc = bpt_canonical(graph, edge_weights);
-        auto &bpt = bptc.tree;
-        auto &altitude = bptc.altitudes;
-        auto &mst = bptc.mst;
-
-        auto bpt_attribute = attribute_functor(bpt, altitude);
-        auto corrected_attribute = watershed_hierarchy_internal::correct_attribute_BPT(bpt, altitude, bpt_attribute);
-        auto persistence = accumulate_parallel(bpt, corrected_attribute, accumulator_min());
-        xt::view(persistence, xt::range(0, num_leaves(bpt))) = 0;
-
-        auto mst_edge_weights = xt::view(persistence, xt::range(num_leaves(bpt), num_vertices(bpt)));
-
-        auto bptc2 = bpt_canonical(mst, mst_edge_weights);
-        auto &bpt2 = bptc2.tree;
-        auto &altitude2 = bptc2.altitudes;
-
-        auto canonical_tree = simplify_tree(bpt2, [&altitude2, &bpt2](index_t i) {
-            return altitude2(i) == altitude2(parent(i, bpt2));
-        });
-        auto canonical_altitude = xt::eval(xt::index_view(altitude2, canonical_tree.node_map));
-
-        return make_node_weighted_tree(std::move(canonical_tree.tree), std::move(canonical_altitude));
+        // the minimum spanning tree is only used through its edge list: no adjacency information is ever built
+        auto bptc = bpt_canonical_edge_list(graph, edge_weights);
+        return watershed_hierarchy_internal::watershed_hierarchy_from_bpt_canonical(
+                num_vertices(graph), bptc, attribute_functor);
     };
 
     /**
@@ -145,7 +165,7 @@ namespace hg {
         auto &minima_altitudes = xminima_altitudes.derived_cast();
         hg_assert_1d_array(minima_altitudes);
 
-        auto bptc = bpt_canonical(graph, edge_weights);
+        auto bptc = bpt_canonical_edge_list(graph, edge_weights);
         auto &bpt = bptc.tree;
         auto &mst = bptc.mst;
 
@@ -156,7 +176,7 @@ namespace hg {
 
         auto mst_edge_weights = xt::view(persistence, xt::range(num_leaves(bpt), num_vertices(bpt)));
 
-        auto bptc2 = bpt_canonical(mst, mst_edge_weights);
+        auto bptc2 = bpt_canonical_edge_list(num_vertices(graph), mst, mst_edge_weights);
         auto &bpt2 = bptc2.tree;
         auto &altitude2 = bptc2.altitudes;
 
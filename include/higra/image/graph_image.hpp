@@ -49,6 +49,42 @@ namespace hg {
         return regular_grid_graph_2d(embedding, std::move(neighbours));
     }
 
+    /**
+     * Create a 4 adjacency grid graph for the given embedding: vertices and edges have the same indices as in the
+     * graph returned by get_4_adjacency_graph but the graph does not store any adjacency list.
+     * @param embedding
+     * @return
+     */
+    inline
+    auto get_4_adjacency_grid_graph(const embedding_grid_2d &embedding) {
+        std::vector<point_2d_i> neighbours{{{-1, 0}},
+                                           {{0,  -1}},
+                                           {{0,  1}},
+                                           {{1,  0}}}; // 4 adjacency
+
+        return grid_graph_2d(embedding, neighbours);
+    }
+
+    /**
+     * Create a 8 adjacency grid graph for the given embedding: vertices and edges have the same indices as in the
+     * graph returned by get_8_adjacency_graph but the graph does not store any adjacency list.
+     * @param embedding
+     * @return
+     */
+    inline
+    auto get_8_adjacency_grid_graph(const embedding_grid_2d &embedding) {
+        std::vector<point_2d_i> neighbours{{{-1, -1}},
+                                           {{-1, 0}},
+                                           {{-1, 1}},
+                                           {{0,  -1}},
+                                           {{0,  1}},
+                                           {{1,  -1}},
+                                           {{1,  0}},
+                                           {{1,  1}}}; // 8 adjacency
+
+        return grid_graph_2d(embedding, neighbours);
+    }
+
     /**
      * Create of 4 adjacency explicit regular graph for the given embedding
      * @param embedding
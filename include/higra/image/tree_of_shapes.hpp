@@ -15,24 +15,173 @@
 #include "higra/hierarchy/component_tree.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
 #include "higra/accumulator/tree_accumulator.hpp"
+#include "higra/sorting.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
 #include "xtensor/xindex_view.hpp"
 
-#include <map>
-#include <deque>
+#include <cstdint>
+#include <vector>
 
 namespace hg {
 
     namespace tree_of_shapes_internal {
 
+        /**
+         * Index of the least significant bit set in a non zero 64 bits word.
+         */
+        inline
+        index_t lowest_bit_index(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return (index_t) __builtin_ctzll((unsigned long long) x);
+#else
+            index_t r = 0;
+            while ((x & 1) == 0) {
+                x >>= 1;
+                r++;
+            }
+            return r;
+#endif
+        }
+
+        /**
+         * Index of the most significant bit set in a non zero 64 bits word.
+         */
+        inline
+        index_t highest_bit_index(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return (index_t) (63 - __builtin_clzll((unsigned long long) x));
+#else
+            index_t r = 0;
+            while (x >>= 1) {
+                r++;
+            }
+            return r;
+#endif
+        }
+
+        /**
+         * A set of integers in [0, size[ stored as a hierarchy of bitsets: the bit i of the level k + 1 is set if the
+         * word i of the level k is not zero.
+         *
+         * Insertion and removal run in O(log_64(size)), and so does the search of the closest element
+         * before or after a given integer.
+         */
+        struct hierarchical_bitset {
+
+            hierarchical_bitset(index_t size = 0) : m_size(size) {
+                index_t num_words = (std::max)((size + 63) / 64, (index_t) 1);
+                m_levels.emplace_back(num_words, 0);
+                while (num_words > 1) {
+                    num_words = (num_words + 63) / 64;
+                    m_levels.emplace_back(num_words, 0);
+                }
+            }
+
+            index_t size() const {
+                return m_size;
+            }
+
+            bool test(index_t i) const {
+                return (m_levels[0][i >> 6] >> (i & 63)) & 1;
+            }
+
+            void set(index_t i) {
+                for (auto &level: m_levels) {
+                    auto &word = level[i >> 6];
+                    bool was_empty = word == 0;
+                    word |= (uint64_t) 1 << (i & 63);
+                    if (!was_empty) {
+                        break;
+                    }
+                    i >>= 6;
+                }
+            }
+
+            void reset(index_t i) {
+                for (auto &level: m_levels) {
+                    auto &word = level[i >> 6];
+                    word &= ~((uint64_t) 1 << (i & 63));
+                    if (word != 0) {
+                        break;
+                    }
+                    i >>= 6;
+                }
+            }
+
+            /**
+             * Smallest element of the set greater than or equal to i
+             * @param i in [0, size[
+             * @return an element of the set or invalid_index
+             */
+            index_t next(index_t i) const {
+                index_t k = 0;
+                while (true) {
+                    auto w = i >> 6;
+                    if (w >= (index_t) m_levels[k].size()) {
+                        return invalid_index;
+                    }
+                    auto word = m_levels[k][w] & (~(uint64_t) 0 << (i & 63));
+                    if (word != 0) {
+                        i = (w << 6) + lowest_bit_index(word);
+                        break;
+                    }
+                    if (k + 1 == (index_t) m_levels.size()) {
+                        return invalid_index;
+                    }
+                    i = w + 1;
+                    k++;
+                }
+                while (k > 0) {
+                    k--;
+                    i = (i << 6) + lowest_bit_index(m_levels[k][i]);
+                }
+                return i;
+            }
+
+            /**
+             * Largest element of the set smaller than or equal to i
+             * @param i in [0, size[
+             * @return an element of the set or invalid_index
+             */
+            index_t previous(index_t i) const {
+                index_t k = 0;
+                while (true) {
+                    auto w = i >> 6;
+                    auto word = m_levels[k][w] & (~(uint64_t) 0 >> (63 - (i & 63)));
+                    if (word != 0) {
+                        i = (w << 6) + highest_bit_index(word);
+                        break;
+                    }
+                    if (k + 1 == (index_t) m_levels.size() || w == 0) {
+                        return invalid_index;
+                    }
+                    i = w - 1;
+                    k++;
+                }
+                while (k > 0) {
+                    k--;
+                    i = (i << 6) + highest_bit_index(m_levels[k][i]);
+                }
+                return i;
+            }
+
+        private:
+            index_t m_size;
+            std::vector<std::vector<uint64_t>> m_levels;
+        };
+
         /**
          * A simple multi-level priority queue with fixed number of integer levels in [min_level, nax_level].
          *
-         * All operations are done in constant time, except:
-         * - constructor, and
-         * - find_closest_non_empty_level
-         * which both run in O(num_levels = max_level - min_level + 1).
+         * Each level is a FIFO list stored in a contiguous buffer with a read position: the buffer of a level is
+         * cleared (keeping its capacity) when the level becomes empty. As the buffers only grow between two
+         * clearings, the total memory used by the queue is linear with respect to the number of levels plus the
+         * total number of elements pushed in the queue.
+         *
+         * Non empty levels are tracked in a hierarchical bitset. All operations are done in constant time, except:
+         * - constructor which runs in O(num_levels = max_level - min_level + 1), and
+         * - find_closest_non_empty_level which runs in O(log_64(num_levels)).
          *
          * @paramt value_t type of sored values
          */
@@ -43,13 +192,15 @@ namespace hg {
 
             /**
              * Create a queue with the given number of levels
-             * @param num_levels queue will have integer levels in [0, num_levels[
+             * @param min_level smallest level of the queue
+             * @param max_level largest level of the queue
              */
             integer_level_multi_queue(level_type min_level, level_type max_level) :
                     m_min_level(min_level),
                     m_max_level(max_level),
-                    m_num_levels(max_level - min_level + 1),
-                    m_data(m_num_levels) {
+                    m_num_levels((index_t) max_level - (index_t) min_level + 1),
+                    m_levels(m_num_levels),
+                    m_non_empty_levels(m_num_levels) {
             }
 
             auto min_level() const {
@@ -90,7 +241,7 @@ namespace hg {
              * @return true if the given level of the queue is empty
              */
             auto level_empty(level_type level) const {
-                return m_data[level - min_level()].size() == 0;
+                return m_levels[index(level)].values.empty();
             }
 
             /**
@@ -99,34 +250,48 @@ namespace hg {
              * @param v new element
              */
             void push(level_type level, value_type v) {
-                m_data[level - min_level()].push_back(v);
+                auto l = index(level);
+                auto &values = m_levels[l].values;
+                if (values.empty()) {
+                    m_non_empty_levels.set(l);
+                }
+                values.push_back(v);
                 m_size++;
             }
 
             /**
-             * Return a reference to the last element of the given queue level
+             * Return a reference to the first element of the given queue level
              * @param level in [min_level, max_level]
              * @return a reference to a value_type element
              */
             auto &top(level_type level) {
-                return m_data[level - min_level()].front();
+                auto &l = m_levels[index(level)];
+                return l.values[l.head];
             }
 
             /**
-            * Return a const reference to the last element of the given queue level
+            * Return a const reference to the first element of the given queue level
             * @param level in [min_level, max_level]
             * @return a const reference to a value_type element
             */
             const auto &top(level_type level) const {
-                return m_data[level - min_level()].front();
+                auto &l = m_levels[index(level)];
+                return l.values[l.head];
             }
 
             /**
-             * Removes the last element of the given queue level
+             * Removes the first element of the given queue level
              * @param level in [min_level, max_level]
              */
             void pop(level_type level) {
-                m_data[level - min_level()].pop_front();
+                auto li = index(level);
+                auto &l = m_levels[li];
+                l.head++;
+                if (l.head == l.values.size()) {
+                    l.values.clear();
+                    l.head = 0;
+                    m_non_empty_levels.reset(li);
+                }
                 m_size--;
             }
 
@@ -135,49 +300,40 @@ namespace hg {
              * In case of equality the smallest level is returned.
              *
              * @param level in [min_level, max_level]
-             * @return a queue level or hg::invalid_index if the queue is empty
+             * @return a queue level
              */
             auto find_closest_non_empty_level(level_type level) const {
                 if (!level_empty(level)) {
                     return level;
                 }
-
-                level_type level_low = level;
-                level_type level_high = level;
-                bool flag_low = true;
-                bool flag_high = true;
-
-                while (flag_low || flag_high) {
-                    if (flag_low) {
-                        if (!level_empty(level_low)) {
-                            return level_low;
-                        }
-                        if (level_low == m_min_level) {
-                            flag_low = false;
-                        } else {
-                            level_low--;
-                        }
-                    }
-                    if (flag_high) {
-                        if (!level_empty(level_high)) {
-                            return level_high;
-                        }
-                        if (level_high == m_max_level) {
-                            flag_high = false;
-                        } else {
-                            level_high++;
-                        }
-                    }
+                auto l = index(level);
+                auto low = m_non_empty_levels.previous(l);
+                auto high = m_non_empty_levels.next(l);
+                if (low == invalid_index && high == invalid_index) {
+                    throw std::runtime_error("Empty queue!");
+                }
+                if (low == invalid_index || (high != invalid_index && high - l < l - low)) {
+                    return (level_type) (m_min_level + high);
                 }
-                throw std::runtime_error("Empty queue!");
-                return (level_type) 0;
+                return (level_type) (m_min_level + low);
             }
 
         private:
+
+            struct level_fifo {
+                std::vector<value_type> values;
+                std::size_t head = 0;
+            };
+
+            index_t index(level_type level) const {
+                return (index_t) level - (index_t) m_min_level;
+            }
+
             level_t m_min_level;
             level_t m_max_level;
             index_t m_num_levels;
-            std::vector<std::deque<value_type>> m_data;
+            std::vector<level_fifo> m_levels;
+            hierarchical_bitset m_non_empty_levels;
             index_t m_size = 0;
         };
 
@@ -229,22 +385,35 @@ namespace hg {
             return plain_map;
         }
 
-        template<typename graph_t,
-                typename T,
-                typename value_type = typename T::value_type,
-                typename std::enable_if_t<sizeof(value_type) <= 2 && std::is_integral<value_type>::value, int> = 0>
-        auto sort_vertices_tree_of_shapes(const graph_t &graph,
-                                          const xt::xexpression<T> &xplain_map, index_t exterior_vertex = 0) {
-
-            auto &plain_map = xplain_map.derived_cast();
+        /**
+         * Sort the vertices of the plain map for the tree of shapes by propagation with a hierarchical queue whose
+         * levels are integers in [min_level, max_level].
+         *
+         * @tparam graph_t
+         * @tparam T
+         * @tparam level_type
+         * @param graph
+         * @param plain_map integer plain map: array of shape (num_vertices, 2) with values in [min_level, max_level]
+         * @param min_level
+         * @param max_level
+         * @param exterior_level level of the exterior vertex
+         * @param exterior_vertex
+         * @return a pair (sorted vertex indices, enqueued levels)
+         */
+        template<typename graph_t, typename T, typename level_type = typename T::value_type>
+        auto sort_vertices_tree_of_shapes_integer_levels(const graph_t &graph,
+                                                         const T &plain_map,
+                                                         level_type min_level,
+                                                         level_type max_level,
+                                                         level_type exterior_level,
+                                                         index_t exterior_vertex) {
             auto num_v = num_vertices(graph);
             array_1d<bool> dejavu({num_v}, false);
             array_1d<index_t> sorted_vertex_indices = array_1d<index_t>::from_shape({num_v});
-            array_1d<value_type> enqueued_level = array_1d<value_type>::from_shape({num_v});
-            integer_level_multi_queue<value_type, index_t> queue(xt::amin(plain_map)(), xt::amax(plain_map)());
+            array_1d<level_type> enqueued_level = array_1d<level_type>::from_shape({num_v});
+            integer_level_multi_queue<level_type, index_t> queue(min_level, max_level);
 
-            value_type current_level = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) /
-                                                     2.0);
+            level_type current_level = exterior_level;
             queue.push(current_level, exterior_vertex);
             dejavu(exterior_vertex) = true;
 
@@ -267,6 +436,35 @@ namespace hg {
             return std::make_pair(std::move(sorted_vertex_indices), std::move(enqueued_level));
         }
 
+        template<typename graph_t,
+                typename T,
+                typename value_type = typename T::value_type,
+                typename std::enable_if_t<sizeof(value_type) <= 2 && std::is_integral<value_type>::value, int> = 0>
+        auto sort_vertices_tree_of_shapes(const graph_t &graph,
+                                          const xt::xexpression<T> &xplain_map, index_t exterior_vertex = 0) {
+
+            auto &plain_map = xplain_map.derived_cast();
+            value_type exterior_level = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) /
+                                                      2.0);
+            return sort_vertices_tree_of_shapes_integer_levels(graph, plain_map,
+                                                               (value_type) xt::amin(plain_map)(),
+                                                               (value_type) xt::amax(plain_map)(),
+                                                               exterior_level,
+                                                               exterior_vertex);
+        }
+
+        /**
+         * Sort the vertices of the plain map for the tree of shapes when the number of possible levels is too large
+         * for a hierarchical queue indexed by values (floating point or large integer values).
+         *
+         * The queue behaves as an ordered multimap of the enqueued (level, vertex) pairs, vertices of a same
+         * level being ordered by insertion: after the processing of an element, the next element is its successor or
+         * its predecessor in the multimap, whichever has the closest level (predecessor in case of equality).
+         *
+         * The values of the plain map are replaced by their ranks among the distinct values of the plain map
+         * (rank transform computed with a radix sort): the multimap is then represented by a list of vertices for
+         * each rank and a hierarchical bitset of the non empty ranks. All queue operations run in O(log_64(n)).
+         */
         template<typename graph_t,
                 typename T,
                 typename value_type = typename T::value_type,
@@ -278,53 +476,130 @@ namespace hg {
             hg_assert(plain_map.dimension() == 2, "Invalid plain map");
             hg_assert(plain_map.shape()[1] == 2, "Invalid plain map");
             hg_assert_vertex_weights(graph, plain_map);
-            auto num_v = num_vertices(graph);
-            array_1d<bool> dejavu({num_v}, false);
-            array_1d<index_t> sorted_vertex_indices = array_1d<index_t>::from_shape({num_v});
-            array_1d<value_type> enqueued_level = array_1d<value_type>::from_shape({num_v});
-
-            std::multimap<value_type, index_t> queue{};
-            auto find_closest_non_empty_level = [&queue](const auto position) {
-                auto next = std::next(position);
-                if (position == queue.begin()) {
-                    return next;
+            index_t num_v = num_vertices(graph);
+            array_1d<bool> dejavu({(size_t) num_v}, false);
+            array_1d<index_t> sorted_vertex_indices = array_1d<index_t>::from_shape({(size_t) num_v});
+            array_1d<value_type> enqueued_level = array_1d<value_type>::from_shape({(size_t) num_v});
+
+            // rank transform, the level of the exterior vertex may not be a value of the plain map
+            array_1d<value_type> values = array_1d<value_type>::from_shape({(size_t) (2 * num_v + 1)});
+            for (index_t i = 0; i < num_v; i++) {
+                values(2 * i) = plain_map(i, 0);
+                values(2 * i + 1) = plain_map(i, 1);
+            }
+            values(2 * num_v) = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) / 2.0);
+
+            auto sorted_values = stable_arg_sort(values);
+            std::vector<value_type> levels;
+            array_2d<index_t> rank_map = array_2d<index_t>::from_shape({(size_t) num_v, (size_t) 2});
+            index_t exterior_rank = 0;
+            for (index_t i = 0; i < (index_t) values.size(); i++) {
+                auto v = sorted_values(i);
+                if (i == 0 || values(v) != values(sorted_values(i - 1))) {
+                    levels.push_back(values(v));
+                }
+                if (v == 2 * num_v) {
+                    exterior_rank = (index_t) levels.size() - 1;
+                } else {
+                    rank_map(v / 2, v % 2) = (index_t) levels.size() - 1;
                 }
-                auto prev = std::prev(position);
-                if (next == queue.end()) {
-                    return prev;
+            }
+            index_t num_levels = (index_t) levels.size();
+            values = array_1d<value_type>();
+            sorted_values = array_1d<index_t>();
+
+            // queue: doubly linked list of the vertices of each rank
+            std::vector<index_t> heads(num_levels, invalid_index);
+            std::vector<index_t> tails(num_levels, invalid_index);
+            array_1d<index_t> next = array_1d<index_t>::from_shape({(size_t) num_v});
+            array_1d<index_t> previous = array_1d<index_t>::from_shape({(size_t) num_v});
+            array_1d<index_t> rank = array_1d<index_t>::from_shape({(size_t) num_v});
+            hierarchical_bitset non_empty_ranks(num_levels);
+
+            auto insert = [&](index_t r, index_t v) {
+                rank(v) = r;
+                previous(v) = tails[r];
+                next(v) = invalid_index;
+                if (tails[r] == invalid_index) {
+                    heads[r] = v;
+                    non_empty_ranks.set(r);
+                } else {
+                    next(tails[r]) = v;
                 }
-                if (next->first - position->first < position->first - prev->first) {
-                    return next;
+                tails[r] = v;
+            };
+
+            auto erase = [&](index_t v) {
+                auto r = rank(v);
+                if (previous(v) != invalid_index) {
+                    next(previous(v)) = next(v);
                 } else {
-                    return prev;
+                    heads[r] = next(v);
+                }
+                if (next(v) != invalid_index) {
+                    previous(next(v)) = previous(v);
+                } else {
+                    tails[r] = previous(v);
+                }
+                if (heads[r] == invalid_index) {
+                    non_empty_ranks.reset(r);
                 }
             };
 
-            value_type current_level = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) /
-                                                     2.0);
+            auto successor = [&](index_t v) {
+                if (next(v) != invalid_index) {
+                    return next(v);
+                }
+                if (rank(v) + 1 == num_levels) {
+                    return invalid_index;
+                }
+                auto r = non_empty_ranks.next(rank(v) + 1);
+                return (r == invalid_index) ? invalid_index : heads[r];
+            };
+
+            auto predecessor = [&](index_t v) {
+                if (previous(v) != invalid_index) {
+                    return previous(v);
+                }
+                if (rank(v) == 0) {
+                    return invalid_index;
+                }
+                auto r = non_empty_ranks.previous(rank(v) - 1);
+                return (r == invalid_index) ? invalid_index : tails[r];
+            };
 
-            auto position = queue.insert({current_level, exterior_vertex});
+            insert(exterior_rank, exterior_vertex);
             dejavu(exterior_vertex) = true;
+            index_t position = exterior_vertex;
 
             index_t i = 0;
             do {
-                current_level = position->first;
-                index_t current_point = position->second;
-
-                enqueued_level(current_point) = current_level;
-                sorted_vertex_indices(i++) = current_point;
-                for (auto n: adjacent_vertex_iterator(current_point, graph)) {
+                auto current_rank = rank(position);
+                auto current_level = levels[current_rank];
+                enqueued_level(position) = current_level;
+                sorted_vertex_indices(i++) = position;
+                for (auto n: adjacent_vertex_iterator(position, graph)) {
                     if (!dejavu(n)) {
-                        auto newLevel = (std::min)(plain_map(n, 1), (std::max)(plain_map(n, 0), current_level));
-                        queue.insert({newLevel, n});
+                        auto new_rank = (std::min)(rank_map(n, 1), (std::max)(rank_map(n, 0), current_rank));
+                        insert(new_rank, n);
                         dejavu(n) = true;
                     }
                 }
 
-                auto new_position = find_closest_non_empty_level(position);
-                queue.erase(position);
-                position = new_position;
-            } while (!queue.empty());
+                auto next_position = successor(position);
+                auto previous_position = predecessor(position);
+                erase(position);
+                if (previous_position == invalid_index) {
+                    position = next_position;
+                } else if (next_position == invalid_index) {
+                    position = previous_position;
+                } else if (levels[rank(next_position)] - current_level <
+                           current_level - levels[rank(previous_position)]) {
+                    position = next_position;
+                } else {
+                    position = previous_position;
+                }
+            } while (position != invalid_index);
             return std::make_pair(std::move(sorted_vertex_indices), std::move(enqueued_level));
         }
 
@@ -0,0 +1,134 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../../utils.hpp"
+#include <string>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define HG_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#define HG_UNDEF_NOMINMAX
+#endif
+
+#include <windows.h>
+
+#ifdef HG_UNDEF_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef HG_UNDEF_WIN32_LEAN_AND_MEAN
+#endif
+#ifdef HG_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef HG_UNDEF_NOMINMAX
+#endif
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+namespace hg {
+    namespace mapped_file_internal {
+
+        /**
+         * Read only memory mapping of a whole file (POSIX mmap or Win32 file mapping).
+         * The mapping is released when the object is destroyed.
+         */
+        class mapped_file {
+        public:
+
+            explicit mapped_file(const std::string &filename) {
+                map(filename);
+            }
+
+            mapped_file(const mapped_file &) = delete;
+
+            mapped_file &operator=(const mapped_file &) = delete;
+
+            ~mapped_file() {
+                unmap();
+            }
+
+            const char *data() const {
+                return m_data;
+            }
+
+            std::size_t size() const {
+                return m_size;
+            }
+
+        private:
+
+#ifdef _WIN32
+
+            void map(const std::string &filename) {
+                HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                          FILE_ATTRIBUTE_NORMAL, nullptr);
+                hg_assert(file != INVALID_HANDLE_VALUE, "Cannot open file '" + filename + "'.");
+                LARGE_INTEGER size;
+                HANDLE mapping = nullptr;
+                if (GetFileSizeEx(file, &size) && size.QuadPart != 0) {
+                    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                }
+                // the mapping stays valid after the handles are closed
+                CloseHandle(file);
+                hg_assert(mapping != nullptr, "Cannot map file '" + filename + "'.");
+                m_data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(mapping);
+                hg_assert(m_data != nullptr, "Cannot map file '" + filename + "'.");
+                m_size = (std::size_t) size.QuadPart;
+            }
+
+            void unmap() {
+                if (m_data != nullptr) {
+                    UnmapViewOfFile(m_data);
+                    m_data = nullptr;
+                }
+            }
+
+#else
+
+            void map(const std::string &filename) {
+                int fd = open(filename.c_str(), O_RDONLY);
+                hg_assert(fd != -1, "Cannot open file '" + filename + "'.");
+                struct stat st;
+                void *data = MAP_FAILED;
+                if (fstat(fd, &st) == 0 && st.st_size != 0) {
+                    data = mmap(nullptr, (std::size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                }
+                // the mapping stays valid after the file descriptor is closed
+                close(fd);
+                hg_assert(data != MAP_FAILED, "Cannot map file '" + filename + "'.");
+                m_data = static_cast<const char *>(data);
+                m_size = (std::size_t) st.st_size;
+            }
+
+            void unmap() {
+                if (m_data != nullptr) {
+                    munmap(const_cast<char *>(m_data), m_size);
+                    m_data = nullptr;
+                }
+            }
+
+#endif
+
+            const char *m_data = nullptr;
+            std::size_t m_size = 0;
+        };
+    }
+}
@@ -0,0 +1,151 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../structure/array.hpp"
+#include "../structure/embedding.hpp"
+#include "details/mapped_file.hpp"
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace hg {
+
+    /**
+     * Tile readers give access, by rectangular tiles, to the edge weights of the 4-adjacency graph of a 2d image
+     * (see get_4_adjacency_graph) that may not fit in memory.
+     *
+     * A tile reader must provide:
+     *  - a type value_type: the type of the edge weights;
+     *  - a method embedding() that returns the embedding_grid_2d of the image;
+     *  - a method read_tile(y, x, height, width) that returns an array of shape (height, width, 2) containing,
+     *    for each pixel p=(y + i, x + j) of the tile, the weight of the edge linking p to its right neighbour
+     *    (y + i, x + j + 1) at position (i, j, 0) and the weight of the edge linking p to its bottom neighbour
+     *    (y + i + 1, x + j) at position (i, j, 1). Values corresponding to neighbours outside the image are ignored.
+     *
+     * The method read_tile may be called concurrently by several threads.
+     */
+
+    /**
+     * Tile reader on an array of edge weights stored in memory: mostly useful for testing purposes.
+     *
+     * @tparam T type of the edge weights array
+     */
+    template<typename T>
+    struct array_tile_reader {
+        using value_type = typename T::value_type;
+
+        /**
+         * @param embedding embedding of the image
+         * @param edge_weights edge weights of the 4-adjacency graph of the image (see get_4_adjacency_graph)
+         */
+        array_tile_reader(const embedding_grid_2d &embedding, const T &edge_weights) :
+                m_embedding(embedding),
+                m_edge_weights(edge_weights) {
+            index_t height = embedding.shape()[0];
+            index_t width = embedding.shape()[1];
+            hg_assert_1d_array(edge_weights);
+            hg_assert((index_t) edge_weights.size() == height * (width - 1) + (height - 1) * width,
+                      "Edge weights size does not match the number of edges of the 4-adjacency graph.");
+        }
+
+        const embedding_grid_2d &embedding() const {
+            return m_embedding;
+        }
+
+        array_3d<value_type> read_tile(index_t y, index_t x, index_t height, index_t width) const {
+            index_t image_height = m_embedding.shape()[0];
+            index_t image_width = m_embedding.shape()[1];
+            array_3d<value_type> tile = xt::zeros<value_type>({(size_t) height, (size_t) width, (size_t) 2});
+            for (index_t i = 0; i < height; i++) {
+                index_t yy = y + i;
+                // edges whose source is in the row yy: right edge then bottom edge of each pixel,
+                // pixels of the last row have no bottom edge
+                index_t row_start = yy * (2 * image_width - 1);
+                for (index_t j = 0; j < width; j++) {
+                    index_t xx = x + j;
+                    if (yy < image_height - 1) {
+                        index_t e = row_start + 2 * xx;
+                        if (xx < image_width - 1) {
+                            tile(i, j, 0) = m_edge_weights(e);
+                            e++;
+                        }
+                        tile(i, j, 1) = m_edge_weights(e);
+                    } else if (xx < image_width - 1) {
+                        tile(i, j, 0) = m_edge_weights(row_start + xx);
+                    }
+                }
+            }
+            return tile;
+        }
+
+    private:
+        embedding_grid_2d m_embedding;
+        const T &m_edge_weights;
+    };
+
+    template<typename T>
+    auto make_array_tile_reader(const embedding_grid_2d &embedding, const xt::xexpression<T> &xedge_weights) {
+        return array_tile_reader<T>(embedding, xedge_weights.derived_cast());
+    }
+
+    /**
+     * Tile reader on a memory mapped raw file.
+     *
+     * The file contains, after an optional header of offset bytes, a C ordered array of shape (height, width, 2)
+     * of values of type T in native byte order: the value at position (y, x, 0) is the weight of the edge
+     * linking the pixel (y, x) to the pixel (y, x + 1) and the value at position (y, x, 1) is the weight of the edge
+     * linking the pixel (y, x) to the pixel (y + 1, x) (see tile readers).
+     *
+     * The file is never loaded as a whole: the operating system pages in the parts that are read by read_tile.
+     *
+     * @tparam T type of the edge weights
+     */
+    template<typename T>
+    struct raw_file_tile_reader {
+        using value_type = T;
+
+        /**
+         * @param filename path to the raw file
+         * @param embedding embedding of the image
+         * @param offset size in bytes of the header preceding the data in the file
+         */
+        raw_file_tile_reader(const std::string &filename, const embedding_grid_2d &embedding, size_t offset = 0) :
+                m_file(std::make_shared<mapped_file_internal::mapped_file>(filename)),
+                m_embedding(embedding),
+                m_offset(offset) {
+            hg_assert(m_file->size() >= offset + embedding.size() * 2 * sizeof(T),
+                      "File '" + filename + "' is too small for the given image size.");
+        }
+
+        const embedding_grid_2d &embedding() const {
+            return m_embedding;
+        }
+
+        array_3d<value_type> read_tile(index_t y, index_t x, index_t height, index_t width) const {
+            index_t image_width = m_embedding.shape()[1];
+            array_3d<value_type> tile = array_3d<value_type>::from_shape({(size_t) height, (size_t) width, (size_t) 2});
+            const char *data = m_file->data() + m_offset;
+            for (index_t i = 0; i < height; i++) {
+                // copy through memcpy: the mapped data may not be correctly aligned for T
+                std::memcpy(&tile(i, 0, 0),
+                            data + ((y + i) * image_width + x) * 2 * sizeof(T),
+                            width * 2 * sizeof(T));
+            }
+            return tile;
+        }
+
+    private:
+        std::shared_ptr<mapped_file_internal::mapped_file> m_file;
+        embedding_grid_2d m_embedding;
+        size_t m_offset;
+    };
+}
@@ -0,0 +1,469 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../structure/tree_graph.hpp"
+#include "details/mapped_file.hpp"
+#include "xtensor/xadapt.hpp"
+#include "xtensor/xeval.hpp"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*
+ * Binary tree container, designed to be memory mapped.
+ *
+ * Layout (all offsets are in bytes from the beginning of the file, all integers are stored in native byte order):
+ *  - file header (64 bytes): magic string, format version, byte order mark, number of sections,
+ *    number of tree nodes, offset of the section table
+ *  - sections: raw arrays of num_nodes elements, each section starts on a 64 bytes boundary
+ *  - section table: one fixed size entry (name, element type, offset, number of elements) per section
+ *
+ * The first section always holds the parent array of the tree (stored with the index_t type of the writer),
+ * the following sections hold the attributes in their own element type (no conversion).
+ */
+namespace hg {
+
+#define HG_TREE_BINARY_IO_VERSION 1
+
+    /**
+     * Element types that can be stored in a binary tree file.
+     */
+    enum class tree_binary_dtype : uint32_t {
+        int8 = 1,
+        uint8 = 2,
+        int16 = 3,
+        uint16 = 4,
+        int32 = 5,
+        uint32 = 6,
+        int64 = 7,
+        uint64 = 8,
+        float32 = 9,
+        float64 = 10
+    };
+
+    namespace tree_binary_io_internal {
+
+        const char magic[8] = {'H', 'G', 'T', 'R', 'E', 'E', 'B', '\0'};
+        const uint32_t byte_order_mark = 0x01020304;
+        const std::size_t section_alignment = 64;
+        const std::size_t max_name_length = 63;
+
+        struct file_header {
+            char magic[8];
+            uint32_t version;
+            uint32_t byte_order_mark;
+            uint64_t num_nodes;
+            uint64_t num_sections;
+            uint64_t section_table_offset;
+            uint8_t reserved[24];
+        };
+
+        static_assert(sizeof(file_header) == 64, "Unexpected binary tree file header size.");
+
+        struct section_entry {
+            char name[max_name_length + 1];
+            uint32_t dtype;
+            uint32_t element_size;
+            uint64_t offset;
+            uint64_t num_elements;
+            uint64_t reserved;
+        };
+
+        static_assert(sizeof(section_entry) == 96, "Unexpected binary tree file section entry size.");
+
+        template<typename T>
+        struct dtype_of;
+
+#define HG_TREE_BINARY_DTYPE(type, code) \
+        template<> \
+        struct dtype_of<type> { \
+            static const tree_binary_dtype value = tree_binary_dtype::code; \
+        };
+
+        HG_TREE_BINARY_DTYPE(int8_t, int8)
+        HG_TREE_BINARY_DTYPE(uint8_t, uint8)
+        HG_TREE_BINARY_DTYPE(int16_t, int16)
+        HG_TREE_BINARY_DTYPE(uint16_t, uint16)
+        HG_TREE_BINARY_DTYPE(int32_t, int32)
+        HG_TREE_BINARY_DTYPE(uint32_t, uint32)
+        HG_TREE_BINARY_DTYPE(int64_t, int64)
+        HG_TREE_BINARY_DTYPE(uint64_t, uint64)
+        HG_TREE_BINARY_DTYPE(float, float32)
+        HG_TREE_BINARY_DTYPE(double, float64)
+
+#undef HG_TREE_BINARY_DTYPE
+
+        inline
+        std::size_t dtype_size(tree_binary_dtype dtype) {
+            switch (dtype) {
+                case tree_binary_dtype::int8:
+                case tree_binary_dtype::uint8:
+                    return 1;
+                case tree_binary_dtype::int16:
+                case tree_binary_dtype::uint16:
+                    return 2;
+                case tree_binary_dtype::int32:
+                case tree_binary_dtype::uint32:
+                case tree_binary_dtype::float32:
+                    return 4;
+                case tree_binary_dtype::int64:
+                case tree_binary_dtype::uint64:
+                case tree_binary_dtype::float64:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
+        struct tree_binary_saver_helper {
+
+            using out_type = std::ostream &;
+
+            tree_binary_saver_helper(out_type out, const tree &t) : m_tree(t), m_out(out) {
+                init();
+            }
+
+            tree_binary_saver_helper(const tree_binary_saver_helper &) = delete;
+
+            tree_binary_saver_helper(tree_binary_saver_helper &&other) :
+                    m_tree(other.m_tree),
+                    m_out(other.m_out),
+                    m_start_position(other.m_start_position),
+                    m_sections(std::move(other.m_sections)),
+                    finalized(other.finalized) {
+                other.finalized = true;
+            }
+
+            ~tree_binary_saver_helper() {
+                finalize();
+            }
+
+            /**
+             * Add a scalar attribute to the file. Attribute values are stored with their own type.
+             * Contiguous arrays are written directly without intermediate copy.
+             *
+             * @param name attribute name (at most 63 characters, unique in the file)
+             * @param xarray 1d array of size num_vertices(tree)
+             * @return *this
+             */
+            template<typename T>
+            tree_binary_saver_helper &add_attribute(const std::string &name, const xt::xexpression<T> &xarray) {
+                auto &&array = xt::eval(xarray.derived_cast());
+                using value_type = typename std::decay_t<decltype(array)>::value_type;
+                hg_assert(!finalized, "Cannot add an attribute to a finalized file.");
+                hg_assert(array.dimension() == 1, "Only scalar attributes are supported.");
+                hg_assert(array.size() == m_tree.num_vertices(), "Attribute size does not match the size of the tree.");
+                hg_assert(name.size() <= max_name_length, "Attribute name is too long.");
+                for (const auto &s: m_sections) {
+                    hg_assert(name != s.name || &s == &m_sections[0], "Duplicated attribute name '" + name + "'.");
+                }
+
+                if (array.size() <= 1 || array.strides()[0] == 1) {
+                    write_section(name, array.data() + array.data_offset(), array.size());
+                } else {
+                    array_1d<value_type> tmp = array;
+                    write_section(name, tmp.data(), tmp.size());
+                }
+                return *this;
+            }
+
+            /**
+             * Write the section table and patch the file header.
+             */
+            void finalize() {
+                if (!finalized) {
+                    pad();
+                    auto table_position = m_out.tellp();
+                    for (const auto &s: m_sections) {
+                        m_out.write(reinterpret_cast<const char *>(&s), sizeof(section_entry));
+                    }
+                    auto end_position = m_out.tellp();
+
+                    file_header header = make_header();
+                    header.num_sections = m_sections.size();
+                    header.section_table_offset = (uint64_t) (table_position - m_start_position);
+                    m_out.seekp(m_start_position);
+                    m_out.write(reinterpret_cast<const char *>(&header), sizeof(file_header));
+                    m_out.seekp(end_position);
+                    m_out.flush();
+                    finalized = true;
+                }
+            }
+
+        private:
+
+            file_header make_header() const {
+                file_header header;
+                std::memset(&header, 0, sizeof(file_header));
+                std::memcpy(header.magic, magic, sizeof(magic));
+                header.version = HG_TREE_BINARY_IO_VERSION;
+                header.byte_order_mark = byte_order_mark;
+                header.num_nodes = m_tree.num_vertices();
+                return header;
+            }
+
+            void init() {
+                m_start_position = m_out.tellp();
+                // header is written again by finalize once the section table position is known
+                file_header header = make_header();
+                m_out.write(reinterpret_cast<const char *>(&header), sizeof(file_header));
+                write_section("parents", m_tree.parents().data(), m_tree.num_vertices());
+            }
+
+            template<typename value_type>
+            void write_section(const std::string &name, const value_type *data, std::size_t num_elements) {
+                pad();
+                section_entry entry;
+                std::memset(&entry, 0, sizeof(section_entry));
+                std::memcpy(entry.name, name.c_str(), name.size());
+                entry.dtype = (uint32_t) dtype_of<value_type>::value;
+                entry.element_size = sizeof(value_type);
+                entry.offset = (uint64_t) (m_out.tellp() - m_start_position);
+                entry.num_elements = num_elements;
+                m_out.write(reinterpret_cast<const char *>(data), std::streamsize(num_elements * sizeof(value_type)));
+                m_sections.push_back(entry);
+            }
+
+            void pad() {
+                static const char zeros[section_alignment] = {};
+                auto position = (std::size_t) (m_out.tellp() - m_start_position);
+                auto rem = position % section_alignment;
+                if (rem != 0) {
+                    m_out.write(zeros, std::streamsize(section_alignment - rem));
+                }
+            }
+
+            const tree &m_tree;
+            out_type m_out;
+            std::ostream::pos_type m_start_position;
+            std::vector<section_entry> m_sections;
+            bool finalized = false;
+        };
+
+    }
+
+    /**
+     * Save a tree in the binary tree format.
+     *
+     * Attributes can be added with the add_attribute method of the returned object; the file is completed
+     * when the finalize method is called or when the returned object is destroyed.
+     * The output stream must be opened in binary mode and must be seekable.
+     *
+     * @param out output stream
+     * @param t input tree
+     * @return a saver helper object
+     */
+    inline
+    auto
+    save_tree_binary(std::ostream &out, const tree &t) {
+        return tree_binary_io_internal::tree_binary_saver_helper(out, t);
+    }
+
+    /**
+     * Read only memory mapping of a file in the binary tree format (see save_tree_binary).
+     *
+     * The parents and the attributes are exposed as views on the mapped memory (no copy, no conversion):
+     * the file content is loaded lazily by the operating system and the mapping is shared by all the processes
+     * that open the same file. Views are valid as long as the mapped_tree_file object is alive.
+     */
+    class mapped_tree_file {
+    public:
+
+        using section_entry = tree_binary_io_internal::section_entry;
+
+        /**
+         * Type of the read only array views returned by parents() and attribute()
+         */
+        template<typename T>
+        using view_type = decltype(xt::adapt(std::declval<const T *>(), std::size_t(), xt::no_ownership(),
+                                             std::declval<std::array<std::size_t, 1>>()));
+
+        /**
+         * Map the given file in memory and check its header and section table.
+         *
+         * @param filename path to a file in the binary tree format
+         */
+        explicit mapped_tree_file(const std::string &filename) :
+                m_file(new mapped_file_internal::mapped_file(filename)),
+                m_data(m_file->data()),
+                m_size(m_file->size()) {
+            check();
+        }
+
+        /**
+         * Number of nodes of the stored tree
+         */
+        std::size_t num_vertices() const {
+            return (std::size_t) header().num_nodes;
+        }
+
+        /**
+         * Zero copy view on the parent array.
+         * The file must have been written with the same index type as the one of the reader.
+         */
+        view_type<index_t> parents() const {
+            const auto &s = section(0);
+            hg_assert(s.dtype == (uint32_t) tree_binary_io_internal::dtype_of<index_t>::value,
+                      "Parents are stored with an index type that is different from hg::index_t.");
+            return view<index_t>(s);
+        }
+
+        /**
+         * Build a tree object from the stored parent array.
+         * The parent array is copied (and converted to index_t if needed).
+         */
+        tree get_tree() const {
+            const auto &s = section(0);
+            switch ((tree_binary_dtype) s.dtype) {
+                case tree_binary_dtype::int32:
+                    return make_tree(view<int32_t>(s));
+                case tree_binary_dtype::int64:
+                    return make_tree(view<int64_t>(s));
+                default:
+                    throw std::runtime_error("Invalid parent array element type.");
+            }
+        }
+
+        /**
+         * Names of the stored attributes, in storage order.
+         */
+        std::vector<std::string> attribute_names() const {
+            std::vector<std::string> res;
+            for (std::size_t i = 1; i < m_num_sections; i++) {
+                res.emplace_back(section(i).name);
+            }
+            return res;
+        }
+
+        bool has_attribute(const std::string &name) const {
+            return find_attribute(name) != nullptr;
+        }
+
+        /**
+         * Element type of the given attribute
+         */
+        tree_binary_dtype attribute_dtype(const std::string &name) const {
+            return (tree_binary_dtype) get_attribute(name).dtype;
+        }
+
+        /**
+         * Pointer to the first element of the given attribute
+         */
+        const void *attribute_data(const std::string &name) const {
+            return m_data + get_attribute(name).offset;
+        }
+
+        /**
+         * Zero copy view on the given attribute.
+         *
+         * @tparam T element type of the attribute, must match the stored element type
+         * @param name attribute name
+         * @return a 1d array view
+         */
+        template<typename T>
+        view_type<T> attribute(const std::string &name) const {
+            const auto &s = get_attribute(name);
+            hg_assert(s.dtype == (uint32_t) tree_binary_io_internal::dtype_of<T>::value,
+                      "Attribute '" + name + "' is not stored with the requested element type.");
+            return view<T>(s);
+        }
+
+    private:
+
+        /**
+         * The parent array comes from an untrusted file: it is fully checked before the tree is built.
+         */
+        template<typename T>
+        static tree make_tree(const T &parents) {
+            index_t num_nodes = (index_t) parents.size();
+            hg_assert(num_nodes > 0, "Binary tree file contains an empty tree.");
+            for (index_t i = 0; i < num_nodes - 1; i++) {
+                index_t p = (index_t) parents(i);
+                hg_assert(p > i && p < num_nodes,
+                          "Corrupted binary tree file: invalid parent " + std::to_string(p) + " for node " +
+                          std::to_string(i) + ".");
+            }
+            hg_assert((index_t) parents(num_nodes - 1) == num_nodes - 1,
+                      "Corrupted binary tree file: the last node is not the root.");
+            return tree(parents);
+        }
+
+        template<typename T>
+        view_type<T> view(const section_entry &s) const {
+            std::array<std::size_t, 1> shape{(std::size_t) s.num_elements};
+            return xt::adapt(reinterpret_cast<const T *>(m_data + s.offset), shape[0], xt::no_ownership(), shape);
+        }
+
+        const tree_binary_io_internal::file_header &header() const {
+            return *reinterpret_cast<const tree_binary_io_internal::file_header *>(m_data);
+        }
+
+        const section_entry &section(std::size_t i) const {
+            return m_sections[i];
+        }
+
+        const section_entry *find_attribute(const std::string &name) const {
+            for (std::size_t i = 1; i < m_num_sections; i++) {
+                if (name == m_sections[i].name) {
+                    return &m_sections[i];
+                }
+            }
+            return nullptr;
+        }
+
+        const section_entry &get_attribute(const std::string &name) const {
+            auto s = find_attribute(name);
+            hg_assert(s != nullptr, "Unknown attribute '" + name + "'.");
+            return *s;
+        }
+
+        void check() {
+            using namespace tree_binary_io_internal;
+            hg_assert(m_size >= sizeof(file_header), "File is too small to be a binary tree file.");
+            const auto &h = header();
+            hg_assert(std::memcmp(h.magic, magic, sizeof(magic)) == 0, "File is not a binary tree file.");
+            hg_assert(h.byte_order_mark == byte_order_mark, "Binary tree file was written with another byte order.");
+            hg_assert(h.version <= HG_TREE_BINARY_IO_VERSION,
+                      "Unsupported binary tree file version " + std::to_string(h.version) + ".");
+            hg_assert(h.num_sections >= 1, "Binary tree file has no parent section.");
+            hg_assert(h.section_table_offset % alignof(section_entry) == 0 &&
+                      h.section_table_offset <= m_size &&
+                      h.num_sections <= (m_size - h.section_table_offset) / sizeof(section_entry),
+                      "Corrupted binary tree file section table.");
+
+            m_num_sections = (std::size_t) h.num_sections;
+            m_sections = reinterpret_cast<const section_entry *>(m_data + h.section_table_offset);
+            for (std::size_t i = 0; i < m_num_sections; i++) {
+                const auto &s = m_sections[i];
+                hg_assert(s.name[max_name_length] == '\0', "Corrupted binary tree file section name.");
+                hg_assert(s.element_size != 0 && dtype_size((tree_binary_dtype) s.dtype) == s.element_size,
+                          "Unknown element type in binary tree file section '" + std::string(s.name) + "'.");
+                hg_assert(s.offset % s.element_size == 0 &&
+                          s.offset <= m_size &&
+                          s.num_elements <= (m_size - s.offset) / s.element_size,
+                          "Corrupted binary tree file section '" + std::string(s.name) + "'.");
+                hg_assert(s.num_elements == h.num_nodes,
+                          "Section '" + std::string(s.name) + "' size does not match the size of the tree.");
+            }
+        }
+
+        std::unique_ptr<mapped_file_internal::mapped_file> m_file;
+        const char *m_data = nullptr;
+        std::size_t m_size = 0;
+        const section_entry *m_sections = nullptr;
+        std::size_t m_num_sections = 0;
+    };
+}
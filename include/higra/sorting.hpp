@@ -21,6 +21,13 @@
 
 #endif
 
+#include "utils.hpp"
+#include "structure/array.hpp"
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
 namespace hg {
     
     template<typename RandomAccessIterator, typename Compare>
@@ -54,4 +61,203 @@ namespace hg {
         typedef typename std::iterator_traits<RandomAccessIterator>::value_type T;
         sort(xs, xe, std::less<T>());
     }
-}
\ No newline at end of file
+
+    namespace sorting_internal {
+
+        /**
+         * Maps a value type to an unsigned integral key type such that the natural order of the values is the
+         * natural order of the keys. value is false if there is no such mapping for the given type.
+         *
+         * @tparam T value type
+         */
+        template<typename T, typename Enable = void>
+        struct radix_key {
+            static const bool value = false;
+        };
+
+        template<typename T>
+        struct radix_key<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+            static const bool value = true;
+            using type = std::make_unsigned_t<T>;
+
+            static type encode(T v) {
+                // flip the sign bit of signed types
+                return static_cast<type>(v) ^
+                       (std::is_signed<T>::value ? (type) ((type) 1 << (sizeof(T) * 8 - 1)) : (type) 0);
+            }
+        };
+
+        template<typename T>
+        struct radix_key<T, std::enable_if_t<std::is_floating_point<T>::value && sizeof(T) == 4>> {
+            static const bool value = true;
+            using type = uint32_t;
+
+            static type encode(T v) {
+                type bits;
+                std::memcpy(&bits, &v, sizeof(type));
+                // -0 and +0 must be equal (checked on bits as fast-math may ignore the sign of zero)
+                if ((bits & ~0x80000000u) == 0) {
+                    bits = 0;
+                }
+                return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+            }
+        };
+
+        template<typename T>
+        struct radix_key<T, std::enable_if_t<std::is_floating_point<T>::value && sizeof(T) == 8>> {
+            static const bool value = true;
+            using type = uint64_t;
+
+            static type encode(T v) {
+                type bits;
+                std::memcpy(&bits, &v, sizeof(type));
+                // -0 and +0 must be equal (checked on bits as fast-math may ignore the sign of zero)
+                if ((bits & ~0x8000000000000000ull) == 0) {
+                    bits = 0;
+                }
+                return (bits & 0x8000000000000000ull) ? ~bits : bits | 0x8000000000000000ull;
+            }
+        };
+
+        /**
+         * Arrays with less elements are sorted with a comparison sort.
+         */
+        const index_t radix_sort_min_size = 1 << 10;
+
+        /**
+         * Stable LSD radix sort of the given keys with 8 bits digits: indices are permuted together with the keys.
+         *
+         * Each pass is decomposed into blocks: histograms and scatter of each block are done in parallel (parfor).
+         * Passes where all the keys share the same digit are skipped.
+         *
+         * @tparam key_t unsigned integral type
+         * @param keys keys to sort (modified)
+         * @param indices indices associated to keys (modified)
+         */
+        template<typename key_t>
+        void radix_sort_by_key(std::vector<key_t> &keys, std::vector<index_t> &indices) {
+            const index_t num_buckets = 256;
+            const index_t block_size = 1 << 16;
+            const index_t size = keys.size();
+            const index_t num_blocks = (size + block_size - 1) / block_size;
+
+            std::vector<key_t> keys_tmp(size);
+            std::vector<index_t> indices_tmp(size);
+            std::vector<index_t> histograms(num_blocks * num_buckets);
+
+            for (index_t shift = 0; shift < (index_t) sizeof(key_t) * 8; shift += 8) {
+                std::fill(histograms.begin(), histograms.end(), 0);
+                parfor(0, num_blocks, [&keys, &histograms, shift, size, block_size, num_buckets](index_t b) {
+                    auto histogram = histograms.begin() + b * num_buckets;
+                    for (index_t i = b * block_size; i < std::min(size, (b + 1) * block_size); i++) {
+                        histogram[(keys[i] >> shift) & 0xFF]++;
+                    }
+                });
+
+                // exclusive prefix sum in (bucket, block) order: gives the first output position of each bucket
+                // in each block
+                bool trivial_pass = false;
+                index_t sum = 0;
+                for (index_t d = 0; d < num_buckets; d++) {
+                    index_t bucket_size = 0;
+                    for (index_t b = 0; b < num_blocks; b++) {
+                        auto &h = histograms[b * num_buckets + d];
+                        auto tmp = h;
+                        h = sum;
+                        sum += tmp;
+                        bucket_size += tmp;
+                    }
+                    if (bucket_size == size) {
+                        trivial_pass = true;
+                        break;
+                    }
+                }
+                if (trivial_pass) {
+                    continue;
+                }
+
+                parfor(0, num_blocks,
+                       [&keys, &indices, &keys_tmp, &indices_tmp, &histograms, shift, size, block_size, num_buckets](
+                               index_t b) {
+                           auto offsets = histograms.begin() + b * num_buckets;
+                           for (index_t i = b * block_size; i < std::min(size, (b + 1) * block_size); i++) {
+                               auto pos = offsets[(keys[i] >> shift) & 0xFF]++;
+                               keys_tmp[pos] = keys[i];
+                               indices_tmp[pos] = indices[i];
+                           }
+                       });
+                keys.swap(keys_tmp);
+                indices.swap(indices_tmp);
+            }
+        }
+
+        template<typename T>
+        auto stable_arg_sort(const T &values, bool descending, std::true_type /* has radix key */) {
+            using radix_key_t = radix_key<typename T::value_type>;
+            using key_t = typename radix_key_t::type;
+            const index_t size = values.size();
+
+            std::vector<key_t> keys(size);
+            if (descending) {
+                parfor(0, size, [&keys, &values](index_t i) {
+                    keys[i] = (key_t) ~radix_key_t::encode(values(i));
+                });
+            } else {
+                parfor(0, size, [&keys, &values](index_t i) {
+                    keys[i] = radix_key_t::encode(values(i));
+                });
+            }
+            std::vector<index_t> indices(size);
+            std::iota(indices.begin(), indices.end(), 0);
+
+            radix_sort_by_key(keys, indices);
+
+            array_1d<index_t> result = array_1d<index_t>::from_shape({(size_t) size});
+            std::copy(indices.begin(), indices.end(), result.begin());
+            return result;
+        }
+
+        template<typename T>
+        auto stable_arg_sort(const T &values, bool descending, std::false_type /* has radix key */) {
+            array_1d<index_t> result = xt::arange<index_t>((index_t) values.size());
+            if (descending) {
+                stable_sort(result.begin(), result.end(),
+                            [&values](index_t i, index_t j) { return values(i) > values(j); });
+            } else {
+                stable_sort(result.begin(), result.end(),
+                            [&values](index_t i, index_t j) { return values(i) < values(j); });
+            }
+            return result;
+        }
+    }
+
+    /**
+     * Indirect stable sort of a 1d array: computes the permutation of indices that sorts the given array
+     * (equal values keep the order of their indices).
+     *
+     * The result is identical to a stable sort of xt::arange(values.size()) with the comparator
+     * values(i) < values(j) (or values(i) > values(j) if descending is true).
+     *
+     * Arrays of integral or floating point values (except very small arrays) are sorted with a LSD radix sort in
+     * linear time (histogram and scatter passes are parallelized if TBB is enabled), other value types use
+     * the comparison based stable_sort.
+     *
+     * @tparam T xexpression derived type
+     * @param xvalues 1d array of values
+     * @param descending if true the values are sorted in decreasing order
+     * @return a 1d array of indices
+     */
+    template<typename T>
+    auto stable_arg_sort(const xt::xexpression<T> &xvalues, bool descending = false) {
+        auto &values = xvalues.derived_cast();
+        hg_assert_1d_array(values);
+        using value_type = typename T::value_type;
+
+        if ((index_t) values.size() < sorting_internal::radix_sort_min_size) {
+            return sorting_internal::stable_arg_sort(values, descending, std::false_type());
+        }
+        return sorting_internal::stable_arg_sort(
+                values, descending,
+                std::integral_constant<bool, sorting_internal::radix_key<value_type>::value>());
+    }
+}
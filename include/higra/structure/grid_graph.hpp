@@ -0,0 +1,667 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+
+#pragma once
+
+#include "details/graph_concepts.hpp"
+#include "details/indexed_edge.hpp"
+#include "details/iterators.hpp"
+#include "embedding.hpp"
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+namespace hg {
+
+    namespace grid_graph_internal {
+
+        // forward declarations
+        struct grid_graph_2d_edge_iterator;
+
+        enum class neighbour_iterator_mode {
+            out_edge,
+            in_edge,
+            adjacent_vertex
+        };
+
+        template<neighbour_iterator_mode mode>
+        struct grid_graph_2d_neighbour_iterator;
+
+        struct grid_graph_traversal_category :
+                virtual public graph::incidence_graph_tag,
+                virtual public graph::bidirectional_graph_tag,
+                virtual public graph::adjacency_graph_tag,
+                virtual public graph::vertex_list_graph_tag,
+                virtual public graph::edge_list_graph_tag {
+        };
+
+        /**
+         * A 2d grid graph with a translation invariant neighbourhood whose edges are never stored.
+         *
+         * Contrarily to regular_graph, edges are indexed: the edge of index i can be obtained in constant time
+         * (with respect to the size of the graph) and the index of the edges adjacent to a vertex can be obtained
+         * in constant time. Edges are numbered in the same order as in copy_graph(regular_graph): this graph
+         * is thus a drop in replacement for the explicit graph returned by get_4_adjacency_graph or
+         * get_8_adjacency_graph, with the same vertex and edge indices, that does not store any adjacency list.
+         *
+         * The neighbourhood must be symmetric and must not contain the origin. A neighbour (dy, dx) is called
+         * forward if dy > 0 or if dy == 0 and dx > 0: the edges are enumerated by increasing linear index of
+         * their source vertex, then following the order of the forward neighbours in the neighbourhood.
+         */
+        class grid_graph_2d {
+
+        public:
+            using self_type = grid_graph_2d;
+
+            // Graph associated types
+            using vertex_descriptor = index_t;
+            using edge_index_t = index_t;
+            using edge_descriptor = indexed_edge<vertex_descriptor, edge_index_t>;
+            using directed_category = graph::undirected_tag;
+            using edge_parallel_category = graph::disallow_parallel_edge_tag;
+            using traversal_category = grid_graph_traversal_category;
+
+            // VertexListGraph associated types
+            using vertex_iterator = counting_iterator<vertex_descriptor>;
+            using vertices_size_type = size_t;
+
+            // EdgeListGraph associated types
+            using edge_iterator = grid_graph_2d_edge_iterator;
+            using edges_size_type = size_t;
+
+            //AdjacencyGraph associated types
+            using adjacency_iterator = grid_graph_2d_neighbour_iterator<neighbour_iterator_mode::adjacent_vertex>;
+
+            // IncidenceGraph associated types
+            using out_edge_iterator = grid_graph_2d_neighbour_iterator<neighbour_iterator_mode::out_edge>;
+            using degree_size_type = size_t;
+
+            //BidirectionalGraph associated types
+            using in_edge_iterator = grid_graph_2d_neighbour_iterator<neighbour_iterator_mode::in_edge>;
+
+            using point_type = point_2d_i;
+
+            grid_graph_2d(const embedding_grid_2d &embedding = {}, const std::vector<point_type> &neighbours = {})
+                    : m_embedding(embedding),
+                      m_neighbours(neighbours),
+                      m_height(embedding.shape()[0]),
+                      m_width(embedding.shape()[1]) {
+                init();
+            }
+
+            vertices_size_type num_vertices() const {
+                return m_embedding.size();
+            }
+
+            edges_size_type num_edges() const {
+                return m_num_edges;
+            }
+
+            const auto &embedding() const {
+                return m_embedding;
+            }
+
+            const auto &neighbours() const {
+                return m_neighbours;
+            }
+
+            /**
+             * Edge of the given index.
+             *
+             * @param ei an edge index
+             * @return an edge descriptor
+             */
+            edge_descriptor edge_from_index(edge_index_t ei) const {
+                index_t y, x, j;
+                locate_edge(ei, y, x, j);
+                index_t v = y * m_width + x;
+                return edge_descriptor(v, v + m_forward_shift[j], ei);
+            }
+
+            /**
+             * Index of the edge linking the vertex (y, x) to its j-th forward neighbour.
+             *
+             * @param y row of the source vertex
+             * @param x column of the source vertex
+             * @param j index of a forward neighbour (see forward_neighbours) such that (y, x) + forward_neighbours[j]
+             *          is in the grid
+             * @return an edge index
+             */
+            edge_index_t edge_index(index_t y, index_t x, index_t j) const {
+                index_t ei = row_start(y) + row_vertex_start(y, x);
+                for (index_t jj = 0; jj < j; jj++) {
+                    if (is_valid_forward_neighbour(y, x, jj)) {
+                        ei++;
+                    }
+                }
+                return ei;
+            }
+
+            /**
+             * Index of the first edge whose source vertex is in the row y.
+             *
+             * @param y a row index
+             * @return an edge index
+             */
+            edge_index_t row_start(index_t y) const {
+                if (y <= m_full_rows) {
+                    return y * m_full_row_num_edges;
+                }
+                edge_index_t ei = m_full_rows * m_full_row_num_edges;
+                for (index_t yy = m_full_rows; yy < y; yy++) {
+                    ei += row_num_edges(yy);
+                }
+                return ei;
+            }
+
+            /**
+             * Forward neighbours (dy, dx) of the neighbourhood, each one is represented by the two values dy and dx.
+             */
+            const auto &forward_neighbours() const {
+                return m_forward;
+            }
+
+            /**
+             * Difference between the linear indices of a vertex and of its j-th forward neighbour.
+             */
+            const auto &forward_shifts() const {
+                return m_forward_shift;
+            }
+
+            /**
+             * True if the j-th forward neighbour of the vertex (y, x) is in the grid.
+             */
+            bool is_valid_forward_neighbour(index_t y, index_t x, index_t j) const {
+                const auto &n = m_forward[j];
+                return y + n[0] < m_height && x + n[1] >= 0 && x + n[1] < m_width;
+            }
+
+            /**
+             * True if the i-th neighbour of the vertex (y, x) is in the grid.
+             */
+            bool is_valid_neighbour(index_t y, index_t x, index_t i) const {
+                const auto &n = m_neighbours[i];
+                index_t ny = y + n[0];
+                index_t nx = x + n[1];
+                return ny >= 0 && ny < m_height && nx >= 0 && nx < m_width;
+            }
+
+            /**
+             * Index of the edge linking the vertex (y, x) to its i-th neighbour.
+             */
+            edge_index_t neighbour_edge_index(index_t y, index_t x, index_t i) const {
+                auto j = m_neighbour_forward_index[i];
+                if (m_neighbour_is_forward[i]) {
+                    return edge_index(y, x, j);
+                } else {
+                    const auto &n = m_neighbours[i];
+                    return edge_index(y + n[0], x + n[1], j);
+                }
+            }
+
+            /**
+             * Difference between the linear indices of a vertex and of its i-th neighbour.
+             */
+            index_t neighbour_shift(index_t i) const {
+                return m_neighbour_shift[i];
+            }
+
+            index_t height() const {
+                return m_height;
+            }
+
+            index_t width() const {
+                return m_width;
+            }
+
+        private:
+
+            void init() {
+                for (index_t i = 0; i < (index_t) m_neighbours.size(); i++) {
+                    index_t dy = m_neighbours[i][0];
+                    index_t dx = m_neighbours[i][1];
+                    hg_assert(dy != 0 || dx != 0, "The neighbourhood must not contain the origin.");
+                    index_t opposite = invalid_index;
+                    for (index_t k = 0; k < (index_t) m_neighbours.size(); k++) {
+                        if (m_neighbours[k][0] == -dy && m_neighbours[k][1] == -dx) {
+                            opposite = k;
+                        }
+                    }
+                    hg_assert(opposite != invalid_index, "The neighbourhood must be symmetric.");
+                    m_neighbour_shift.push_back(dy * m_width + dx);
+                    if (dy > 0 || (dy == 0 && dx > 0)) {
+                        m_neighbour_is_forward.push_back(true);
+                        m_neighbour_forward_index.push_back(m_forward.size());
+                        m_forward.push_back({dy, dx});
+                        m_forward_shift.push_back(dy * m_width + dx);
+                    } else {
+                        m_neighbour_is_forward.push_back(false);
+                        m_neighbour_forward_index.push_back(invalid_index);
+                    }
+                }
+                // backward neighbours are associated to the forward index of their opposite
+                for (index_t i = 0; i < (index_t) m_neighbours.size(); i++) {
+                    if (!m_neighbour_is_forward[i]) {
+                        for (index_t j = 0; j < (index_t) m_forward.size(); j++) {
+                            if (m_forward[j][0] == -m_neighbours[i][0] && m_forward[j][1] == -m_neighbours[i][1]) {
+                                m_neighbour_forward_index[i] = j;
+                            }
+                        }
+                    }
+                }
+
+                index_t max_dy = 0;
+                for (const auto &n: m_forward) {
+                    max_dy = (std::max)(max_dy, n[0]);
+                    m_left = (std::max)(m_left, -n[1]);
+                    m_right = (std::max)(m_right, n[1]);
+                }
+                m_full_rows = (std::max)((index_t) 0, m_height - max_dy);
+                m_full_row_num_edges = (m_full_rows > 0) ? row_num_edges(0) : 0;
+                m_num_edges = row_start(m_height);
+            }
+
+            // pixels of a row with an index smaller than left_band_end or greater than or equal to right_band_begin
+            // may have forward neighbours outside of the grid
+            index_t left_band_end() const {
+                return (std::min)(m_left, m_width);
+            }
+
+            index_t right_band_begin() const {
+                return (std::max)(left_band_end(), m_width - m_right);
+            }
+
+            // number of forward neighbours of a vertex of the row y, not in a left or right band
+            index_t row_num_forward_neighbours(index_t y) const {
+                index_t c = 0;
+                for (const auto &n: m_forward) {
+                    if (y + n[0] < m_height) {
+                        c++;
+                    }
+                }
+                return c;
+            }
+
+            index_t row_num_edges(index_t y) const {
+                index_t c = 0;
+                for (const auto &n: m_forward) {
+                    if (y + n[0] < m_height) {
+                        c += (std::max)((index_t) 0, m_width - std::abs(n[1]));
+                    }
+                }
+                return c;
+            }
+
+            index_t vertex_num_edges(index_t y, index_t x) const {
+                index_t c = 0;
+                for (index_t j = 0; j < (index_t) m_forward.size(); j++) {
+                    if (is_valid_forward_neighbour(y, x, j)) {
+                        c++;
+                    }
+                }
+                return c;
+            }
+
+            // number of edges whose source is in the row y before the vertex (y, x)
+            index_t row_vertex_start(index_t y, index_t x) const {
+                index_t xl = left_band_end();
+                index_t xr = right_band_begin();
+                index_t ei = 0;
+                for (index_t xx = 0; xx < (std::min)(x, xl); xx++) {
+                    ei += vertex_num_edges(y, xx);
+                }
+                if (x > xl) {
+                    ei += ((std::min)(x, xr) - xl) * row_num_forward_neighbours(y);
+                    for (index_t xx = xr; xx < x; xx++) {
+                        ei += vertex_num_edges(y, xx);
+                    }
+                }
+                return ei;
+            }
+
+            // index j of the r-th forward neighbour of the vertex (y, x) inside the grid
+            index_t valid_forward_neighbour(index_t y, index_t x, index_t r) const {
+                index_t j = 0;
+                for (;; j++) {
+                    if (is_valid_forward_neighbour(y, x, j)) {
+                        if (r == 0) {
+                            return j;
+                        }
+                        r--;
+                    }
+                }
+            }
+
+            // the edge of index ei links the vertex (y, x) to its j-th forward neighbour
+            void locate_edge(edge_index_t ei, index_t &y, index_t &x, index_t &j) const {
+                index_t o;
+                if (ei < m_full_rows * m_full_row_num_edges) {
+                    y = ei / m_full_row_num_edges;
+                    o = ei % m_full_row_num_edges;
+                } else {
+                    y = m_full_rows;
+                    o = ei - m_full_rows * m_full_row_num_edges;
+                    for (index_t n = row_num_edges(y); o >= n; n = row_num_edges(y)) {
+                        o -= n;
+                        y++;
+                    }
+                }
+
+                index_t xl = left_band_end();
+                index_t xr = right_band_begin();
+                for (x = 0; x < xl; x++) {
+                    index_t n = vertex_num_edges(y, x);
+                    if (o < n) {
+                        j = valid_forward_neighbour(y, x, o);
+                        return;
+                    }
+                    o -= n;
+                }
+
+                index_t c = row_num_forward_neighbours(y);
+                index_t n = (xr - xl) * c;
+                if (o < n) {
+                    x = xl + o / c;
+                    j = valid_forward_neighbour(y, x, o % c);
+                    return;
+                }
+                o -= n;
+
+                for (x = xr;; x++) {
+                    n = vertex_num_edges(y, x);
+                    if (o < n) {
+                        j = valid_forward_neighbour(y, x, o);
+                        return;
+                    }
+                    o -= n;
+                }
+            }
+
+            friend struct grid_graph_2d_edge_iterator;
+
+            embedding_grid_2d m_embedding;
+            std::vector<point_type> m_neighbours;
+            index_t m_height;
+            index_t m_width;
+
+            std::vector<std::array<index_t, 2>> m_forward;
+            std::vector<index_t> m_forward_shift;
+            std::vector<index_t> m_neighbour_shift;
+            std::vector<bool> m_neighbour_is_forward;
+            std::vector<index_t> m_neighbour_forward_index;
+
+            index_t m_left = 0;
+            index_t m_right = 0;
+            // rows whose vertices all have their forward neighbours inside the grid (except on the left and
+            // right bands)
+            index_t m_full_rows = 0;
+            index_t m_full_row_num_edges = 0;
+            index_t m_num_edges = 0;
+        };
+
+        /**
+         * Enumeration of the edges of a grid graph in increasing index order.
+         *
+         * Incrementing the iterator does not require any edge index to edge conversion; random accesses rely on
+         * grid_graph_2d::edge_from_index.
+         */
+        struct grid_graph_2d_edge_iterator :
+                public random_iterator_facade<grid_graph_2d_edge_iterator,
+                        grid_graph_2d::edge_descriptor,
+                        grid_graph_2d::edge_descriptor> {
+
+            using edge_descriptor = grid_graph_2d::edge_descriptor;
+
+            grid_graph_2d_edge_iterator() {}
+
+            grid_graph_2d_edge_iterator(const grid_graph_2d &graph, index_t index) :
+                    m_graph(&graph) {
+                seek(index);
+            }
+
+            void increment() {
+                index_t num_forward = m_graph->m_forward.size();
+                index_t height = m_graph->m_height;
+                index_t width = m_graph->m_width;
+                m_index++;
+                if (m_index >= (index_t) m_graph->num_edges()) {
+                    return;
+                }
+                do {
+                    m_j++;
+                    if (m_j == num_forward) {
+                        m_j = 0;
+                        m_x++;
+                        if (m_x == width) {
+                            m_x = 0;
+                            m_y++;
+                        }
+                    }
+                } while (m_y < height && !m_graph->is_valid_forward_neighbour(m_y, m_x, m_j));
+            }
+
+            void decrement() {
+                seek(m_index - 1);
+            }
+
+            void advance(std::ptrdiff_t n) {
+                seek(m_index + n);
+            }
+
+            auto distance_to(const grid_graph_2d_edge_iterator &other) const {
+                return other.m_index - m_index;
+            }
+
+            bool equal(const grid_graph_2d_edge_iterator &other) const {
+                return m_index == other.m_index;
+            }
+
+            edge_descriptor dereference() const {
+                index_t v = m_y * m_graph->m_width + m_x;
+                return edge_descriptor(v, v + m_graph->m_forward_shift[m_j], m_index);
+            }
+
+        private:
+
+            void seek(index_t index) {
+                m_index = index;
+                if (m_index >= 0 && m_index < (index_t) m_graph->num_edges()) {
+                    m_graph->locate_edge(m_index, m_y, m_x, m_j);
+                }
+            }
+
+            const grid_graph_2d *m_graph = nullptr;
+            index_t m_y = 0;
+            index_t m_x = 0;
+            index_t m_j = 0;
+            index_t m_index = 0;
+        };
+
+        /**
+         * Enumeration of the neighbours of a vertex, of its out edges or of its in edges.
+         */
+        template<neighbour_iterator_mode mode>
+        struct grid_graph_2d_neighbour_iterator :
+                public forward_iterator_facade<grid_graph_2d_neighbour_iterator<mode>,
+                        std::conditional_t<mode == neighbour_iterator_mode::adjacent_vertex, index_t, grid_graph_2d::edge_descriptor>,
+                        std::conditional_t<mode == neighbour_iterator_mode::adjacent_vertex, index_t, grid_graph_2d::edge_descriptor>> {
+
+            using value_type = std::conditional_t<mode == neighbour_iterator_mode::adjacent_vertex,
+                    index_t,
+                    grid_graph_2d::edge_descriptor>;
+
+            grid_graph_2d_neighbour_iterator() {}
+
+            grid_graph_2d_neighbour_iterator(const grid_graph_2d &graph, index_t v, bool end) :
+                    m_graph(&graph),
+                    m_v(v),
+                    m_y(v / graph.width()),
+                    m_x(v % graph.width()) {
+                if (end) {
+                    m_i = graph.neighbours().size();
+                } else {
+                    m_i = -1;
+                    increment();
+                }
+            }
+
+            void increment() {
+                index_t num_neighbours = m_graph->neighbours().size();
+                do {
+                    m_i++;
+                } while (m_i < num_neighbours && !m_graph->is_valid_neighbour(m_y, m_x, m_i));
+            }
+
+            bool equal(const grid_graph_2d_neighbour_iterator &other) const {
+                return m_i == other.m_i;
+            }
+
+            value_type dereference() const {
+                return dereference_impl(std::integral_constant<neighbour_iterator_mode, mode>());
+            }
+
+        private:
+
+            index_t dereference_impl(
+                    std::integral_constant<neighbour_iterator_mode, neighbour_iterator_mode::adjacent_vertex>) const {
+                return m_v + m_graph->neighbour_shift(m_i);
+            }
+
+            grid_graph_2d::edge_descriptor dereference_impl(
+                    std::integral_constant<neighbour_iterator_mode, neighbour_iterator_mode::out_edge>) const {
+                return grid_graph_2d::edge_descriptor(m_v,
+                                                      m_v + m_graph->neighbour_shift(m_i),
+                                                      m_graph->neighbour_edge_index(m_y, m_x, m_i));
+            }
+
+            grid_graph_2d::edge_descriptor dereference_impl(
+                    std::integral_constant<neighbour_iterator_mode, neighbour_iterator_mode::in_edge>) const {
+                return grid_graph_2d::edge_descriptor(m_v + m_graph->neighbour_shift(m_i),
+                                                      m_v,
+                                                      m_graph->neighbour_edge_index(m_y, m_x, m_i));
+            }
+
+            const grid_graph_2d *m_graph = nullptr;
+            index_t m_v = 0;
+            index_t m_y = 0;
+            index_t m_x = 0;
+            index_t m_i = 0;
+        };
+    }
+
+    using grid_graph_2d = grid_graph_internal::grid_graph_2d;
+
+    namespace graph {
+        template<>
+        struct graph_traits<hg::grid_graph_2d> {
+            using G = hg::grid_graph_2d;
+
+            using vertex_descriptor = typename G::vertex_descriptor;
+            using edge_descriptor = typename G::edge_descriptor;
+            using edge_iterator = typename G::edge_iterator;
+            using out_edge_iterator = typename G::out_edge_iterator;
+
+            using directed_category = typename G::directed_category;
+            using edge_parallel_category = typename G::edge_parallel_category;
+            using traversal_category = typename G::traversal_category;
+
+            using degree_size_type = typename G::degree_size_type;
+
+            using in_edge_iterator = typename G::in_edge_iterator;
+            using vertex_iterator = typename G::vertex_iterator;
+            using vertices_size_type = typename G::vertices_size_type;
+            using edges_size_type = typename G::edges_size_type;
+            using adjacency_iterator = typename G::adjacency_iterator;
+
+            using edge_index = typename G::edge_index_t;
+        };
+    }
+
+    inline
+    grid_graph_2d::vertices_size_type
+    num_vertices(const grid_graph_2d &g) {
+        return g.num_vertices();
+    }
+
+    inline
+    grid_graph_2d::edges_size_type
+    num_edges(const grid_graph_2d &g) {
+        return g.num_edges();
+    }
+
+    inline
+    grid_graph_2d::edge_descriptor
+    edge_from_index(grid_graph_2d::edge_index_t ei, const grid_graph_2d &g) {
+        return g.edge_from_index(ei);
+    }
+
+    inline
+    std::pair<grid_graph_2d::vertex_iterator, grid_graph_2d::vertex_iterator>
+    vertices(const grid_graph_2d &g) {
+        using vertex_iterator = grid_graph_2d::vertex_iterator;
+        return std::make_pair(
+                vertex_iterator(0),                 // The first iterator position
+                vertex_iterator(num_vertices(g))); // The last iterator position
+    }
+
+    inline
+    std::pair<grid_graph_2d::edge_iterator, grid_graph_2d::edge_iterator>
+    edges(const grid_graph_2d &g) {
+        using it = grid_graph_2d::edge_iterator;
+        return std::make_pair(it(g, 0), it(g, num_edges(g)));
+    }
+
+    inline
+    std::pair<grid_graph_2d::out_edge_iterator, grid_graph_2d::out_edge_iterator>
+    out_edges(grid_graph_2d::vertex_descriptor v, const grid_graph_2d &g) {
+        using it = grid_graph_2d::out_edge_iterator;
+        return std::make_pair(it(g, v, false), it(g, v, true));
+    }
+
+    inline
+    std::pair<grid_graph_2d::in_edge_iterator, grid_graph_2d::in_edge_iterator>
+    in_edges(grid_graph_2d::vertex_descriptor v, const grid_graph_2d &g) {
+        using it = grid_graph_2d::in_edge_iterator;
+        return std::make_pair(it(g, v, false), it(g, v, true));
+    }
+
+    inline
+    std::pair<grid_graph_2d::adjacency_iterator, grid_graph_2d::adjacency_iterator>
+    adjacent_vertices(grid_graph_2d::vertex_descriptor v, const grid_graph_2d &g) {
+        using it = grid_graph_2d::adjacency_iterator;
+        return std::make_pair(it(g, v, false), it(g, v, true));
+    }
+
+    inline
+    grid_graph_2d::degree_size_type
+    out_degree(grid_graph_2d::vertex_descriptor v, const grid_graph_2d &g) {
+        grid_graph_2d::degree_size_type count = 0;
+        auto it = adjacent_vertices(v, g);
+        for (auto b = it.first; b != it.second; ++b) {
+            count++;
+        }
+        return count;
+    }
+
+    inline
+    grid_graph_2d::degree_size_type
+    in_degree(grid_graph_2d::vertex_descriptor v, const grid_graph_2d &g) {
+        return out_degree(v, g);
+    }
+
+    inline
+    grid_graph_2d::degree_size_type
+    degree(grid_graph_2d::vertex_descriptor v, const grid_graph_2d &g) {
+        return out_degree(v, g);
+    }
+}
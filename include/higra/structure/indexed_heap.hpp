@@ -0,0 +1,206 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../utils.hpp"
+#include <vector>
+
+namespace hg {
+
+    /**
+     * Array based indexed d-ary min-heap.
+     *
+     * The heap stores a subset of the keys {0, ..., capacity - 1}, each key being associated to a value.
+     * Keys are ordered by increasing value, ties being broken by increasing key.
+     *
+     * Contrarily to the fibonacci_heap, elements are not referenced by handles but directly by their key:
+     * the position of each key in the heap is tracked in an array such that the value of any key can be updated
+     * (increased or decreased) and any key can be removed from the heap in O(d log_d(n)).
+     *
+     * The heap does not allocate memory after its construction.
+     *
+     * @tparam T Value type, must implement operator <
+     * @tparam arity Number of children of each node of the heap
+     */
+    template<typename T, index_t arity = 4>
+    struct indexed_heap {
+        static_assert(arity >= 2, "Heap arity must be greater than or equal to 2.");
+
+    private:
+
+        std::vector<index_t> m_heap;
+        std::vector<index_t> m_positions;
+        std::vector<T> m_values;
+
+    public:
+
+        /**
+         * Creates an empty heap that can contain the keys {0, ..., capacity - 1}
+         * @param capacity
+         */
+        indexed_heap(index_t capacity = 0) :
+                m_positions(capacity, invalid_index),
+                m_values(capacity) {
+            m_heap.reserve(capacity);
+        }
+
+        /**
+         * Test if heap is empty
+         * @return
+         */
+        bool empty() const {
+            return m_heap.empty();
+        }
+
+        /**
+         * Number of keys in the heap
+         * @return
+         */
+        size_t size() const {
+            return m_heap.size();
+        }
+
+        /**
+         * Test if the given key is in the heap
+         * @param key
+         * @return
+         */
+        bool contains(index_t key) const {
+            return m_positions[key] != invalid_index;
+        }
+
+        /**
+         * Value associated to the given key (the key must be in the heap)
+         * @param key
+         * @return
+         */
+        const T &value(index_t key) const {
+            return m_values[key];
+        }
+
+        /**
+         * Key associated to the smallest value
+         * @return
+         */
+        index_t top() const {
+            return m_heap[0];
+        }
+
+        /**
+         * Smallest value in the heap
+         * @return
+         */
+        const T &top_value() const {
+            return m_values[m_heap[0]];
+        }
+
+        /**
+         * Insert a new key in the heap (the key must not be in the heap)
+         *
+         * @param key
+         * @param value
+         */
+        void push(index_t key, const T &value) {
+            m_values[key] = value;
+            m_positions[key] = (index_t) m_heap.size();
+            m_heap.push_back(key);
+            sift_up(m_positions[key]);
+        }
+
+        /**
+         * Removes the key with the smallest value from the heap
+         */
+        void pop() {
+            erase(m_heap[0]);
+        }
+
+        /**
+         * Removes the given key from the heap (the key must be in the heap)
+         * @param key
+         */
+        void erase(index_t key) {
+            index_t position = m_positions[key];
+            index_t last = m_heap.back();
+            m_heap.pop_back();
+            m_positions[key] = invalid_index;
+            if (last != key) {
+                m_heap[position] = last;
+                m_positions[last] = position;
+                restore(position);
+            }
+        }
+
+        /**
+         * Change the value associated to the given key (the key must be in the heap)
+         * @param key
+         * @param value
+         */
+        void update(index_t key, const T &value) {
+            m_values[key] = value;
+            restore(m_positions[key]);
+        }
+
+    private:
+
+        bool less(index_t key1, index_t key2) const {
+            return m_values[key1] < m_values[key2] || (!(m_values[key2] < m_values[key1]) && key1 < key2);
+        }
+
+        void restore(index_t position) {
+            if (position > 0 && less(m_heap[position], m_heap[(position - 1) / arity])) {
+                sift_up(position);
+            } else {
+                sift_down(position);
+            }
+        }
+
+        void sift_up(index_t position) {
+            index_t key = m_heap[position];
+            while (position > 0) {
+                index_t parent = (position - 1) / arity;
+                if (!less(key, m_heap[parent])) {
+                    break;
+                }
+                m_heap[position] = m_heap[parent];
+                m_positions[m_heap[position]] = position;
+                position = parent;
+            }
+            m_heap[position] = key;
+            m_positions[key] = position;
+        }
+
+        void sift_down(index_t position) {
+            index_t key = m_heap[position];
+            index_t size = (index_t) m_heap.size();
+            while (true) {
+                index_t first_child = position * arity + 1;
+                if (first_child >= size) {
+                    break;
+                }
+                index_t last_child = (std::min)(first_child + arity, size);
+                index_t min_child = first_child;
+                for (index_t c = first_child + 1; c < last_child; c++) {
+                    if (less(m_heap[c], m_heap[min_child])) {
+                        min_child = c;
+                    }
+                }
+                if (!less(m_heap[min_child], key)) {
+                    break;
+                }
+                m_heap[position] = m_heap[min_child];
+                m_positions[m_heap[position]] = position;
+                position = min_child;
+            }
+            m_heap[position] = key;
+            m_positions[key] = position;
+        }
+    };
+}
@@ -11,149 +11,192 @@
 #pragma once
 
 #include "../graph.hpp"
-#include <stack>
+#include <cstdint>
+#include <limits>
 
 namespace hg {
     namespace lca_internal {
 
         /**
-         * n x log(n) pre-processing of a tree to obtain a constant query time for lowest common ancestors of two nodes
+         * Floor of the base 2 logarithm of a strictly positive integer.
+         */
+        inline
+        int floor_log2(std::size_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return (int) (sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long) x);
+#else
+            int r = 0;
+            while (x >>= 1) {
+                r++;
+            }
+            return r;
+#endif
+        }
+
+        /**
+         * Linear pre-processing of a tree to obtain a constant query time for lowest common ancestors of two nodes.
+         *
+         * Nodes are numbered in depth first preorder. Let u and v be two distinct nodes with preorder ranks
+         * ru < rv: the lowest common ancestor of u and v is the node whose preorder rank is the minimum, over the
+         * ranks r in ]ru, rv], of the preorder rank of the parent of the node of rank r.
+         *
+         * These range minimum queries are answered with a block decomposition: the sequence is divided into blocks of
+         * block_size elements, prefix and suffix minima are stored for each block and a sparse table is built over the
+         * minima of the blocks. The memory footprint is thus about 5 * n + (n / block_size) * log(n / block_size)
+         * values of type value_t.
+         *
          * @tparam tree_t
+         * @tparam value_t integral type used to store node indices (the number of nodes of the tree must be
+         * representable with this type)
          */
-        template<typename tree_t>
+        template<typename tree_t, typename value_t = std::int32_t>
         struct lca_fast {
         public:
+
+            using value_type = value_t;
+
+            static const index_t block_size = 32;
+
             template<typename T1, typename T2>
             struct internal_state {
 
                 size_t m_num_vertices;
-                T1 m_Euler;
-                T1 m_Depth;
-                T1 m_Represent;
-                T1 m_Number;
-                T2 m_Minim;
-                size_t m_rep;
+                T1 m_preorder;
+                T1 m_nodes;
+                T1 m_values;
+                T1 m_prefix_min;
+                T1 m_suffix_min;
+                T2 m_sparse_table;
 
                 internal_state(size_t num_vertices,
-                               const T1 &Euler,
-                               const T1 &Depth,
-                               const T1 &Represent,
-                               const T1 &Number,
-                               const T2 &Minim,
-                               size_t rep) :
+                               const T1 &preorder,
+                               const T1 &nodes,
+                               const T1 &values,
+                               const T1 &prefix_min,
+                               const T1 &suffix_min,
+                               const T2 &sparse_table) :
                         m_num_vertices(num_vertices),
-                        m_Euler(Euler),
-                        m_Depth(Depth),
-                        m_Represent(Represent),
-                        m_Number(Number),
-                        m_Minim(Minim),
-                        m_rep(rep) {}
+                        m_preorder(preorder),
+                        m_nodes(nodes),
+                        m_values(values),
+                        m_prefix_min(prefix_min),
+                        m_suffix_min(suffix_min),
+                        m_sparse_table(sparse_table) {}
 
                 internal_state(size_t num_vertices,
-                               T1 &&Euler,
-                               T1 &&Depth,
-                               T1 &&Represent,
-                               T1 &&Number,
-                               T2 &&Minim,
-                               size_t rep) :
+                               T1 &&preorder,
+                               T1 &&nodes,
+                               T1 &&values,
+                               T1 &&prefix_min,
+                               T1 &&suffix_min,
+                               T2 &&sparse_table) :
                         m_num_vertices(num_vertices),
-                        m_Euler(std::forward<T1>(Euler)),
-                        m_Depth(std::forward<T1>(Depth)),
-                        m_Represent(std::forward<T1>(Represent)),
-                        m_Number(std::forward<T1>(Number)),
-                        m_Minim(std::forward<T2>(Minim)),
-                        m_rep(rep) {}
+                        m_preorder(std::forward<T1>(preorder)),
+                        m_nodes(std::forward<T1>(nodes)),
+                        m_values(std::forward<T1>(values)),
+                        m_prefix_min(std::forward<T1>(prefix_min)),
+                        m_suffix_min(std::forward<T1>(suffix_min)),
+                        m_sparse_table(std::forward<T2>(sparse_table)) {}
             };
 
         private:
 
-            using array = xt::xtensor<std::size_t, 1>;
-            using array2d = xt::xtensor<std::size_t, 2>;
+            using array = array_1d<value_t>;
+            using array2d = array_2d<value_t>;
             using vertex_t = typename tree_t::vertex_descriptor;
 
             size_t m_num_vertices;
 
-            array Euler;
-            array Depth;
-            array Represent;
-            array Number;
-            array2d Minim;
-
-            size_t rep = 0;
-
-            void computeDepth(const tree_t &tree) {
-                Depth[root(tree)] = 0;
-                for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-                    Depth[i] = Depth[parent(i, tree)] + 1;
+            // preorder rank of each node
+            array m_preorder;
+            // node of each preorder rank
+            array m_nodes;
+            // preorder rank of the parent of the node of each preorder rank
+            array m_values;
+            // minimum of values from the beginning of the block to the current position
+            array m_prefix_min;
+            // minimum of values from the current position to the end of the block
+            array m_suffix_min;
+            // m_sparse_table(j, b) = minimum of values in the blocks b, ..., b + 2^j - 1
+            array2d m_sparse_table;
+
+            void compute_preorder(const tree_t &tree) {
+                auto num_v = m_num_vertices;
+                array subtree_size = xt::ones<value_t>({num_v});
+                for (auto i: leaves_to_root_iterator(tree, leaves_it::include, root_it::exclude)) {
+                    subtree_size(parent(i, tree)) += subtree_size(i);
                 }
-            }
 
-            void LCApreprocessEuler(const tree_t &tree) {
-                struct se {
-                    index_t node;
-                    bool first_visit;
-                };
-
-                index_t nbr = -1;
-
-                std::stack<se> stack;
-                stack.push({tree.root(), true});
-                while (!stack.empty()) {
-                    auto e = stack.top();
-                    stack.pop();
-                    nbr++;
-                    Euler[nbr] = e.node;
-                    if (e.first_visit) {
-                        Number[e.node] = nbr;
-                        Represent[nbr] = e.node;
-                        for (auto son: children_iterator(e.node, tree)) {
-                            stack.push({e.node, false});
-                            stack.push({son, true});
-                        }
+                m_preorder(root(tree)) = 0;
+                for (auto i: root_to_leaves_iterator(tree, leaves_it::exclude)) {
+                    value_t rank = m_preorder(i) + 1;
+                    for (auto c: children_iterator(i, tree)) {
+                        m_preorder(c) = rank;
+                        rank += subtree_size(c);
                     }
                 }
-            }
 
+                for (index_t i = 0; i < (index_t) num_v; i++) {
+                    m_nodes(m_preorder(i)) = (value_t) i;
+                }
+            }
 
-            void LCApreprocess(const tree_t &tree) {
-                //O(n.log(n)) preprocessing
-
-                computeDepth(tree);
-                LCApreprocessEuler(tree);
-                index_t nbNodes = m_num_vertices;
-                index_t nbRepresent = 2 * nbNodes - 1;
-
-                int logn = (int) (ceil(log((double) (nbRepresent)) / log(2.0)));
-
-                Minim.resize({(size_t) logn, (size_t) nbRepresent});
+            void compute_block_minima(const tree_t &tree) {
+                index_t num_v = m_num_vertices;
+                index_t num_blocks = (num_v + block_size - 1) / block_size;
 
-                parfor(0, nbRepresent - 1, [this](index_t i) {
-                    if (this->Depth[this->Euler[i]] < this->Depth[this->Euler[i + 1]]) {
-                        this->Minim(0, i) = i;
-                    } else {
-                        this->Minim(0, i) = i + 1;
+                // the root has no parent: its value is never used in queries
+                parfor(0, num_blocks, [this, &tree, num_v](index_t b) {
+                    index_t block_begin = b * block_size;
+                    index_t block_end = (std::min)(block_begin + block_size, num_v);
+                    for (index_t i = block_begin; i < block_end; i++) {
+                        m_values(i) = (i == 0) ? 0 : m_preorder(parent(m_nodes(i), tree));
+                    }
+                    m_prefix_min(block_begin) = m_values(block_begin);
+                    for (index_t i = block_begin + 1; i < block_end; i++) {
+                        m_prefix_min(i) = (std::min)(m_prefix_min(i - 1), m_values(i));
+                    }
+                    m_suffix_min(block_end - 1) = m_values(block_end - 1);
+                    for (index_t i = block_end - 2; i >= block_begin; i--) {
+                        m_suffix_min(i) = (std::min)(m_suffix_min(i + 1), m_values(i));
                     }
                 });
-                Minim(0, nbRepresent - 1) = nbRepresent - 1;
-
-                for (int j = 1; j < logn; j++) {
-                    index_t k1 = (index_t) (1 << (j - 1));
-                    index_t k2 = k1 << 1;
-                    parfor(0, nbRepresent, [this, k1, k2, j, nbRepresent](index_t i) {
-                        if ((i + k2) >= nbRepresent) {
-                            Minim(j, i) = nbRepresent - 1;
-                        } else {
-                            if (this->Depth[this->Euler[this->Minim(j - 1, i)]] <=
-                                this->Depth[this->Euler[this->Minim(j - 1, i + k1)]]) {
-                                this->Minim(j, i) = this->Minim(j - 1, i);
-                            } else {
-                                this->Minim(j, i) = this->Minim(j - 1, i + k1);
-                            }
-                        }
+
+                index_t num_levels = floor_log2(num_blocks) + 1;
+                m_sparse_table = xt::zeros<value_t>({(size_t) num_levels, (size_t) num_blocks});
+                parfor(0, num_blocks, [this, num_v](index_t b) {
+                    m_sparse_table(0, b) = m_prefix_min((std::min)((b + 1) * block_size, num_v) - 1);
+                });
+                for (index_t j = 1; j < num_levels; j++) {
+                    index_t half = (index_t) 1 << (j - 1);
+                    parfor(0, num_blocks - 2 * half + 1, [this, j, half](index_t b) {
+                        m_sparse_table(j, b) = (std::min)(m_sparse_table(j - 1, b), m_sparse_table(j - 1, b + half));
                     });
                 }
             }
 
+            /**
+             * Minimum of values in the range [first, last], first <= last
+             */
+            value_t range_min(index_t first, index_t last) const {
+                index_t block_first = first / block_size;
+                index_t block_last = last / block_size;
+                if (block_first == block_last) {
+                    value_t res = m_values(first);
+                    for (index_t i = first + 1; i <= last; i++) {
+                        res = (std::min)(res, m_values(i));
+                    }
+                    return res;
+                }
+                value_t res = (std::min)(m_suffix_min(first), m_prefix_min(last));
+                if (block_last - block_first > 1) {
+                    int k = floor_log2(block_last - block_first - 1);
+                    res = (std::min)(res, (std::min)(m_sparse_table(k, block_first + 1),
+                                                     m_sparse_table(k, block_last - ((index_t) 1 << k))));
+                }
+                return res;
+            }
+
             lca_fast() {
                 HG_TRACE();
                 m_num_vertices = 0;
@@ -162,23 +205,23 @@ namespace hg {
             template<typename T1, typename T2>
             void set_state(const internal_state<T1, T2> &state) {
                 m_num_vertices = state.m_num_vertices;
-                Euler = state.m_Euler;
-                Depth = state.m_Depth;
-                Represent = state.m_Represent;
-                Number = state.m_Number;
-                Minim = state.m_Minim;
-                rep = state.m_rep;
+                m_preorder = state.m_preorder;
+                m_nodes = state.m_nodes;
+                m_values = state.m_values;
+                m_prefix_min = state.m_prefix_min;
+                m_suffix_min = state.m_suffix_min;
+                m_sparse_table = state.m_sparse_table;
             }
 
             template<typename T1, typename T2>
             void set_state(internal_state<T1, T2> &&state) {
                 m_num_vertices = state.m_num_vertices;
-                Euler = std::move(state.m_Euler);
-                Depth = std::move(state.m_Depth);
-                Represent = std::move(state.m_Represent);
-                Number = std::move(state.m_Number);
-                Minim = std::move(state.m_Minim);
-                rep = state.m_rep;
+                m_preorder = std::move(state.m_preorder);
+                m_nodes = std::move(state.m_nodes);
+                m_values = std::move(state.m_values);
+                m_prefix_min = std::move(state.m_prefix_min);
+                m_suffix_min = std::move(state.m_suffix_min);
+                m_sparse_table = std::move(state.m_sparse_table);
             }
 
         public:
@@ -186,14 +229,17 @@ namespace hg {
             lca_fast(const tree_t &tree) {
                 HG_TRACE();
                 auto nbNodes = hg::num_vertices(tree);
+                hg_assert(nbNodes <= (size_t) (std::numeric_limits<value_t>::max)(),
+                          "Tree is too large for the index type of lca_fast.");
                 m_num_vertices = nbNodes;
-                Depth.resize({nbNodes});
-                Number.resize({nbNodes});
-
-                Euler.resize({2 * nbNodes - 1});
-                Represent.resize({2 * nbNodes - 1});
-
-                LCApreprocess(tree);
+                m_preorder.resize({nbNodes});
+                m_nodes.resize({nbNodes});
+                m_values.resize({nbNodes});
+                m_prefix_min.resize({nbNodes});
+                m_suffix_min.resize({nbNodes});
+
+                compute_preorder(tree);
+                compute_block_minima(tree);
             }
 
             /**
@@ -203,26 +249,14 @@ namespace hg {
              * @return
              */
             vertex_t lca(vertex_t n1, vertex_t n2) const {
-                index_t ii, jj, kk;
-                int k;
-                ii = Number[n1];
-                jj = Number[n2];
-                if (ii == jj)
-                    return Represent[ii];
-
-                if (ii > jj) {
-                    kk = jj;
-                    jj = ii;
-                    ii = kk;
-                }
-
-                k = (int) (log((double) (jj - ii)) / log(2.));
-
-                if (Depth[Euler[Minim(k, ii)]] < Depth[Euler[Minim(k, jj - (index_t) (1 << (k)))]]) {
-                    return Represent[Number[Euler[Minim(k, ii)]]];
-                } else {
-                    return Represent[Number[Euler[Minim(k, jj - (index_t) (1 << k))]]];
+                index_t r1 = m_preorder(n1);
+                index_t r2 = m_preorder(n2);
+                if (r1 == r2)
+                    return n1;
+                if (r1 > r2) {
+                    std::swap(r1, r2);
                 }
+                return m_nodes(range_min(r1 + 1, r2));
             }
 
             /**
@@ -250,6 +284,8 @@ namespace hg {
              * this function returns a 1d array or tree vertex indices of size n such that
              * for all i in 0..n-1, res(i) = lca(v1(i); v2(i))
              *
+             * Queries are processed by blocks of contiguous pairs, blocks are processed in parallel.
+             *
              * @tparam T
              * @param xvertices1 first array of graph vertices
              * @param xvertices2 second array of graph vertices
@@ -264,11 +300,16 @@ namespace hg {
                 hg_assert_integral_value_type(vertices1);
                 hg_assert_same_shape(vertices1, vertices2);
 
-                auto size = vertices1.size();
-                auto result = array_1d<vertex_t>::from_shape({size});
+                index_t size = vertices1.size();
+                auto result = array_1d<vertex_t>::from_shape({(size_t) size});
 
-                parfor(0, size, [&vertices1, &vertices2, &result, this](index_t i) {
-                    result(i) = this->lca(vertices1(i), vertices2(i));
+                const index_t query_block_size = 1 << 12;
+                index_t num_blocks = (size + query_block_size - 1) / query_block_size;
+                parfor(0, num_blocks, [&vertices1, &vertices2, &result, size, query_block_size, this](index_t b) {
+                    index_t block_end = (std::min)((b + 1) * query_block_size, size);
+                    for (index_t i = b * query_block_size; i < block_end; i++) {
+                        result(i) = this->lca(vertices1(i), vertices2(i));
+                    }
                 });
                 return result;
             }
@@ -277,6 +318,14 @@ namespace hg {
                 return m_num_vertices;
             }
 
+            /**
+             * Memory used by the preprocessing in bytes
+             * @return
+             */
+            std::size_t memory_size() const {
+                return (5 * m_num_vertices + m_sparse_table.size()) * sizeof(value_t);
+            }
+
 
             /**
              * Returns a copy of the internal state of the object (can be saved/loaded/transmitted...)
@@ -284,12 +333,12 @@ namespace hg {
              */
             auto get_state() const {
                 return internal_state<array, array2d>(m_num_vertices,
-                                                      Euler,
-                                                      Depth,
-                                                      Represent,
-                                                      Number,
-                                                      Minim,
-                                                      rep);
+                                                      m_preorder,
+                                                      m_nodes,
+                                                      m_values,
+                                                      m_prefix_min,
+                                                      m_suffix_min,
+                                                      m_sparse_table);
             }
 
             template<typename T1, typename T2>
@@ -310,4 +359,18 @@ namespace hg {
     }
 
     using lca_fast = lca_internal::lca_fast<tree>;
-}
\ No newline at end of file
+
+    /**
+     * Lowest common ancestor preprocessing of the given tree (see lca_fast) stored in the global result cache:
+     * the preprocessing of a tree is shared by all the algorithms working on this tree.
+     *
+     * @param tree input tree
+     * @return a shared pointer on a constant lca_fast
+     */
+    inline
+    auto cached_lca_fast(const tree &tree) {
+        return result_cache::global().get_or_compute<lca_fast>(tree, "lca_fast", [&tree]() {
+            return lca_fast(tree);
+        });
+    }
+}
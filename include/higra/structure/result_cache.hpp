@@ -0,0 +1,413 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../utils.hpp"
+#include "array.hpp"
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace hg {
+
+    /**
+     * Identity of an object (tree, graph...) for the result cache.
+     *
+     * A copy of an object is considered as a new object and gets a new identity. An object must call modified()
+     * each time its content changes: results computed on previous versions of the object are then not used anymore.
+     * A moved-from object has no identity: results are never cached for it.
+     */
+    class cache_identity {
+    public:
+
+        cache_identity() : m_token(std::make_shared<char>(0)) {
+        }
+
+        cache_identity(const cache_identity &) : cache_identity() {
+        }
+
+        cache_identity(cache_identity &&other) noexcept = default;
+
+        cache_identity &operator=(const cache_identity &) {
+            m_token = std::make_shared<char>(0);
+            m_version = 0;
+            return *this;
+        }
+
+        cache_identity &operator=(cache_identity &&other) noexcept = default;
+
+        void modified() {
+            m_version++;
+        }
+
+        const std::shared_ptr<char> &token() const {
+            return m_token;
+        }
+
+        std::uint64_t version() const {
+            return m_version;
+        }
+
+    private:
+        std::shared_ptr<char> m_token;
+        std::uint64_t m_version = 0;
+    };
+
+    namespace result_cache_internal {
+
+        template<typename T>
+        auto memory_size(const T &value) -> decltype(value.memory_size()) {
+            return value.memory_size();
+        }
+
+        template<typename T, std::size_t N>
+        std::size_t memory_size(const xt::xtensor<T, N> &value) {
+            return value.size() * sizeof(T);
+        }
+    }
+
+    /**
+     * Process wide cache of results derived from an object (tree, graph...) that are expensive to compute and that
+     * are used by several algorithms, e.g. the lowest common ancestor preprocessing or the area of a tree.
+     *
+     * An entry is identified by its owner (an object providing a method identity() returning a cache_identity) and
+     * a name. The cache only holds weak references on owners: the entries of an object are released once the object
+     * is destroyed (lazily, at the next insertion in the cache).
+     *
+     * The total memory used by the entries is bounded by a memory limit: when inserting a new entry, the least
+     * recently used entries are evicted until the limit is satisfied. Entries larger than the memory limit are not
+     * stored and a limit equal to 0 disables the cache. Results are shared: an evicted result stays alive as long as
+     * a caller uses it.
+     *
+     * All methods are thread safe. Results are computed outside of the cache lock: two threads requesting
+     * simultaneously the same missing entry may both compute it.
+     */
+    class result_cache {
+    public:
+
+        static const std::size_t default_memory_limit = (std::size_t) 1 << 30;
+
+        /**
+         * The global cache instance used by the library
+         * @return
+         */
+        static result_cache &global() {
+            static result_cache cache;
+            return cache;
+        }
+
+        result_cache(std::size_t memory_limit = default_memory_limit) : m_memory_limit(memory_limit) {
+        }
+
+        /**
+         * Get the result named name associated to the given owner: if no such result is in the cache, it is
+         * computed with the given function and stored in the cache.
+         *
+         * The type result_t must be the same for all the calls with a same name. The memory used by the result
+         * is given by result_cache_internal::memory_size.
+         *
+         * @tparam result_t type of the result
+         * @tparam owner_t
+         * @tparam F function returning a result_t
+         * @param owner
+         * @param name
+         * @param compute
+         * @return a shared pointer on a constant result_t
+         */
+        template<typename result_t, typename owner_t, typename F>
+        std::shared_ptr<const result_t> get_or_compute(const owner_t &owner, const std::string &name, F &&compute) {
+            return get_or_compute<result_t>(owner, name, std::forward<F>(compute),
+                                            [](const result_t &) { return true; });
+        }
+
+        /**
+         * Same as get_or_compute(owner, name, compute) except that a result found in the cache is only used if
+         * is_valid(result) is true: this allows to cache results that depend on other parameters than the owner
+         * (only the result corresponding to the last parameters is then stored).
+         *
+         * @tparam result_t type of the result
+         * @tparam owner_t
+         * @tparam F function returning a result_t
+         * @tparam V function taking a const result_t reference and returning a bool
+         * @param owner
+         * @param name
+         * @param compute
+         * @param is_valid
+         * @return a shared pointer on a constant result_t
+         */
+        template<typename result_t, typename owner_t, typename F, typename V>
+        std::shared_ptr<const result_t> get_or_compute(const owner_t &owner,
+                                                       const std::string &name,
+                                                       F &&compute,
+                                                       V &&is_valid) {
+            const auto &identity = owner.identity();
+            if (!identity.token() || !enabled()) {
+                return std::make_shared<const result_t>(compute());
+            }
+            auto found = std::static_pointer_cast<const result_t>(find_entry(identity, name));
+            bool hit = found && is_valid(*found);
+            record_request(hit);
+            if (hit) {
+                return found;
+            }
+            auto value = std::make_shared<const result_t>(compute());
+            put_entry(identity, name, value, result_cache_internal::memory_size(*value));
+            return value;
+        }
+
+        /**
+         * Get the result named name associated to the given owner if it is in the cache.
+         *
+         * @tparam result_t type of the result
+         * @tparam owner_t
+         * @param owner
+         * @param name
+         * @return a shared pointer on a constant result_t (nullptr if the result is not in the cache)
+         */
+        template<typename result_t, typename owner_t>
+        std::shared_ptr<const result_t> get(const owner_t &owner, const std::string &name) {
+            auto found = std::static_pointer_cast<const result_t>(find_entry(owner.identity(), name));
+            record_request((bool) found);
+            return found;
+        }
+
+        /**
+         * Store the result named name associated to the given owner (replacing any previous result with this name).
+         *
+         * @tparam result_t type of the result
+         * @tparam owner_t
+         * @param owner
+         * @param name
+         * @param value
+         * @param memory_size memory used by the result in bytes
+         */
+        template<typename result_t, typename owner_t>
+        void put(const owner_t &owner,
+                 const std::string &name,
+                 std::shared_ptr<const result_t> value,
+                 std::size_t memory_size) {
+            put_entry(owner.identity(), name, std::move(value), memory_size);
+        }
+
+        /**
+         * Remove all the results associated to the given owner
+         * @tparam owner_t
+         * @param owner
+         */
+        template<typename owner_t>
+        void invalidate(const owner_t &owner) {
+            const auto &token = owner.identity().token();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.lower_bound({token.get(), std::string()});
+            while (it != m_entries.end() && it->first.first == token.get()) {
+                it = erase(it);
+            }
+        }
+
+        /**
+         * Remove all the results from the cache (statistics are not modified)
+         */
+        void clear() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_entries.clear();
+            m_lru.clear();
+            m_memory_usage = 0;
+        }
+
+        /**
+         * Set the maximal memory (in bytes) used by the results stored in the cache: entries are evicted if needed.
+         * A limit equal to 0 disables the cache.
+         * @param memory_limit
+         */
+        void set_memory_limit(std::size_t memory_limit) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_memory_limit = memory_limit;
+            evict(0);
+        }
+
+        std::size_t memory_limit() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_memory_limit;
+        }
+
+        /**
+         * Activates or deactivates the cache: when the cache is deactivated, results are always computed and never
+         * stored (results already in the cache are kept).
+         * @param enabled
+         */
+        void set_enabled(bool enabled) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_enabled = enabled;
+        }
+
+        /**
+         * True if the cache is activated and its memory limit is not 0
+         * @return
+         */
+        bool enabled() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_enabled && m_memory_limit > 0;
+        }
+
+        /**
+         * Memory (in bytes) used by the results stored in the cache
+         * @return
+         */
+        std::size_t memory_usage() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_memory_usage;
+        }
+
+        /**
+         * Number of results stored in the cache
+         * @return
+         */
+        std::size_t num_entries() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        /**
+         * Number of requests that found their result in the cache
+         * @return
+         */
+        std::size_t hits() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+        /**
+         * Number of requests that did not find their result in the cache
+         * @return
+         */
+        std::size_t misses() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_misses;
+        }
+
+        /**
+         * Number of results removed from the cache because of the memory limit
+         * @return
+         */
+        std::size_t evictions() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_evictions;
+        }
+
+        void reset_statistics() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_hits = 0;
+            m_misses = 0;
+            m_evictions = 0;
+        }
+
+    private:
+
+        using key_type = std::pair<const char *, std::string>;
+
+        struct entry {
+            std::weak_ptr<char> owner;
+            std::uint64_t version;
+            std::shared_ptr<const void> value;
+            std::size_t memory_size;
+            std::list<key_type>::iterator lru_position;
+        };
+
+        using entry_map = std::map<key_type, entry>;
+
+        // entry of the given owner and name (nullptr if there is no such entry or if the entry is outdated)
+        std::shared_ptr<const void> find_entry(const cache_identity &identity, const std::string &name) {
+            const auto &token = identity.token();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find({token.get(), name});
+            // the owner token may have been destroyed and its address reused, or the owner may have been modified
+            if (it == m_entries.end() ||
+                it->second.owner.owner_before(token) || token.owner_before(it->second.owner) ||
+                it->second.version != identity.version()) {
+                return nullptr;
+            }
+            m_lru.splice(m_lru.begin(), m_lru, it->second.lru_position);
+            return it->second.value;
+        }
+
+        void record_request(bool hit) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (hit) {
+                m_hits++;
+            } else {
+                m_misses++;
+            }
+        }
+
+        template<typename result_t>
+        void put_entry(const cache_identity &identity,
+                       const std::string &name,
+                       std::shared_ptr<const result_t> value,
+                       std::size_t memory_size) {
+            const auto &token = identity.token();
+            if (!token) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            key_type key{token.get(), name};
+            auto it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                erase(it);
+            }
+            if (memory_size > m_memory_limit) {
+                return;
+            }
+            remove_expired();
+            evict(memory_size);
+            m_lru.push_front(key);
+            m_entries.emplace(key, entry{token, identity.version(), std::move(value), memory_size, m_lru.begin()});
+            m_memory_usage += memory_size;
+        }
+
+        entry_map::iterator erase(entry_map::iterator it) {
+            m_memory_usage -= it->second.memory_size;
+            m_lru.erase(it->second.lru_position);
+            return m_entries.erase(it);
+        }
+
+        void remove_expired() {
+            for (auto it = m_entries.begin(); it != m_entries.end();) {
+                if (it->second.owner.expired()) {
+                    it = erase(it);
+                } else {
+                    it++;
+                }
+            }
+        }
+
+        // evict least recently used entries until memory_size bytes can be added without exceeding the limit
+        void evict(std::size_t memory_size) {
+            while (!m_lru.empty() && m_memory_usage + memory_size > m_memory_limit) {
+                erase(m_entries.find(m_lru.back()));
+                m_evictions++;
+            }
+        }
+
+        mutable std::mutex m_mutex;
+        entry_map m_entries;
+        std::list<key_type> m_lru;
+        std::size_t m_memory_limit;
+        bool m_enabled = true;
+        std::size_t m_memory_usage = 0;
+        std::size_t m_hits = 0;
+        std::size_t m_misses = 0;
+        std::size_t m_evictions = 0;
+    };
+}
@@ -0,0 +1,270 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../graph.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace hg {
+
+    /**
+     * Sparse intersection (contingency) table between two labelisations of a same set of elements.
+     *
+     * Row i of the table contains the non zero numbers of elements shared by the region i of the first labelisation
+     * with each region j of the second labelisation. Rows are stored contiguously (compressed sparse row format):
+     * the non zero entries of row i are given, by increasing column index j, by
+     * columns[row_begin[i]:row_begin[i + 1]] and values[row_begin[i]:row_begin[i + 1]].
+     *
+     * The memory used by the table is proportional to its number of rows plus its number of non zero entries.
+     *
+     * @tparam value_t type of table values
+     */
+    template<typename value_t = index_t>
+    struct sparse_intersection_table {
+        using value_type = value_t;
+
+        array_1d<index_t> row_begin;
+        array_1d<index_t> columns;
+        array_1d<value_type> values;
+        index_t num_columns = 0;
+
+        index_t num_rows() const {
+            return (index_t) row_begin.size() - 1;
+        }
+
+        index_t num_non_zeros() const {
+            return (index_t) columns.size();
+        }
+
+        /**
+         * Sum of each row of the table (number of elements of each region of the first labelisation)
+         * @return
+         */
+        array_1d<value_type> row_sums() const {
+            array_1d<value_type> res = xt::zeros<value_type>({(size_t) num_rows()});
+            for (index_t i = 0; i < num_rows(); i++) {
+                for (index_t k = row_begin(i); k < row_begin(i + 1); k++) {
+                    res(i) += values(k);
+                }
+            }
+            return res;
+        }
+
+        /**
+         * Dense version of the table: a 2d array of size num_rows() x num_columns
+         * @return
+         */
+        array_2d<value_type> to_dense() const {
+            array_2d<value_type> res = xt::zeros<value_type>({(size_t) num_rows(), (size_t) num_columns});
+            for (index_t i = 0; i < num_rows(); i++) {
+                for (index_t k = row_begin(i); k < row_begin(i + 1); k++) {
+                    res(i, columns(k)) = values(k);
+                }
+            }
+            return res;
+        }
+    };
+
+    namespace sparse_intersection_table_internal {
+
+        /**
+         * Incrementally builds a sparse_intersection_table row by row.
+         *
+         * Entries of the current row can be added in any order and with repetitions: they are summed and sorted by
+         * column when the row is closed. A dense work array of size num_columns is used to locate the entries of the
+         * current row.
+         *
+         * @tparam value_t
+         */
+        template<typename value_t>
+        struct sparse_intersection_table_builder {
+
+            sparse_intersection_table_builder(index_t num_rows, index_t num_columns) :
+                    m_positions({(size_t) num_columns}, invalid_index) {
+                m_table.row_begin = array_1d<index_t>::from_shape({(size_t) num_rows + 1});
+                m_table.row_begin(0) = 0;
+                m_table.num_columns = num_columns;
+            }
+
+            void add(index_t column, value_t value) {
+                if (m_positions(column) == invalid_index) {
+                    m_positions(column) = (index_t) m_entries.size();
+                    m_entries.emplace_back(column, value);
+                } else {
+                    m_entries[m_positions(column)].second += value;
+                }
+            }
+
+            void close_row() {
+                auto row_start = m_entries.begin() + m_row_start;
+                for (auto it = row_start; it != m_entries.end(); it++) {
+                    m_positions(it->first) = invalid_index;
+                }
+                std::sort(row_start, m_entries.end(),
+                          [](const auto &a, const auto &b) { return a.first < b.first; });
+                m_row_start = m_entries.size();
+                m_table.row_begin(++m_current_row) = (index_t) m_row_start;
+            }
+
+            /**
+             * Start of the given closed row in the list of entries
+             * @param row
+             * @return
+             */
+            index_t row_begin(index_t row) const {
+                return m_table.row_begin(row);
+            }
+
+            /**
+             * Entry (column, value) at the given position in the list of entries (returned by value as adding
+             * new entries may invalidate references)
+             * @param position
+             * @return
+             */
+            std::pair<index_t, value_t> entry(index_t position) const {
+                return m_entries[position];
+            }
+
+            sparse_intersection_table<value_t> finalize() {
+                m_table.columns = array_1d<index_t>::from_shape({m_entries.size()});
+                m_table.values = array_1d<value_t>::from_shape({m_entries.size()});
+                for (index_t k = 0; k < (index_t) m_entries.size(); k++) {
+                    m_table.columns(k) = m_entries[k].first;
+                    m_table.values(k) = m_entries[k].second;
+                }
+                return std::move(m_table);
+            }
+
+        private:
+            sparse_intersection_table<value_t> m_table;
+            array_1d<index_t> m_positions;
+            std::vector<std::pair<index_t, value_t>> m_entries;
+            size_t m_row_start = 0;
+            index_t m_current_row = 0;
+        };
+    }
+
+    /**
+     * Sparse intersection table between two labelisations of a same set of elements.
+     *
+     * Pre-condition:
+     *  range(xlabelisation_rows) = [0..num_rows[
+     *  range(xlabelisation_columns) = [0..num_columns[
+     *
+     * If num_rows or num_columns are not provided, they will
+     * be determined as max(xlabelisation_rows) + 1 and max(xlabelisation_columns) + 1
+     *
+     * Elements are first sorted by row label with a counting sort: the memory used is linear with respect
+     * to the number of elements, the number of rows, the number of columns and the number of non zero
+     * intersections.
+     *
+     * @tparam value_t type of table values
+     * @tparam T1
+     * @tparam T2
+     * @param xlabelisation_rows labelisation of the elements defining the rows of the table
+     * @param xlabelisation_columns labelisation of the elements defining the columns of the table
+     * @param num_rows number of rows of the table
+     * @param num_columns number of columns of the table
+     * @return a sparse_intersection_table
+     */
+    template<typename value_t = index_t, typename T1, typename T2>
+    auto make_sparse_intersection_table(const xt::xexpression<T1> &xlabelisation_rows,
+                                        const xt::xexpression<T2> &xlabelisation_columns,
+                                        index_t num_rows = 0,
+                                        index_t num_columns = 0) {
+        auto &labelisation_rows = xlabelisation_rows.derived_cast();
+        auto &labelisation_columns = xlabelisation_columns.derived_cast();
+        hg_assert_integral_value_type(labelisation_rows);
+        hg_assert_integral_value_type(labelisation_columns);
+        hg_assert(labelisation_rows.size() == labelisation_columns.size(),
+                  "Labelisations must have the same size.");
+
+        const auto rows = xt::flatten(labelisation_rows);
+        const auto cols = xt::flatten(labelisation_columns);
+        index_t num_elements = (index_t) rows.size();
+
+        if (num_rows == 0 && num_elements > 0) {
+            num_rows = (index_t) xt::amax(rows)() + 1;
+        }
+        if (num_columns == 0 && num_elements > 0) {
+            num_columns = (index_t) xt::amax(cols)() + 1;
+        }
+
+        // counting sort of the elements by row label
+        array_1d<index_t> offsets = xt::zeros<index_t>({(size_t) num_rows + 1});
+        for (index_t i = 0; i < num_elements; i++) {
+            offsets((index_t) rows(i) + 1)++;
+        }
+        for (index_t i = 0; i < num_rows; i++) {
+            offsets(i + 1) += offsets(i);
+        }
+        array_1d<index_t> sorted_columns = array_1d<index_t>::from_shape({(size_t) num_elements});
+        {
+            array_1d<index_t> positions = offsets;
+            for (index_t i = 0; i < num_elements; i++) {
+                sorted_columns(positions((index_t) rows(i))++) = (index_t) cols(i);
+            }
+        }
+
+        sparse_intersection_table_internal::sparse_intersection_table_builder<value_t> builder(num_rows, num_columns);
+        for (index_t r = 0; r < num_rows; r++) {
+            for (index_t k = offsets(r); k < offsets(r + 1); k++) {
+                builder.add(sorted_columns(k), 1);
+            }
+            builder.close_row();
+        }
+        return builder.finalize();
+    }
+
+    /**
+     * Given a sparse intersection table whose rows correspond to the leaves of a tree, computes the sparse
+     * intersection table whose rows correspond to all the nodes of the tree: the row of a non leaf node
+     * is the sum of the rows of its children.
+     *
+     * The memory used is linear with respect to the number of tree nodes, the number of columns and the number of
+     * non zero entries of the result.
+     *
+     * @tparam tree_t
+     * @tparam value_t
+     * @param tree input tree
+     * @param leaf_table sparse intersection table with num_leaves(tree) rows
+     * @return a sparse_intersection_table with num_vertices(tree) rows
+     */
+    template<typename tree_t, typename value_t>
+    auto accumulate_sparse_intersection_table(const tree_t &tree,
+                                              const sparse_intersection_table<value_t> &leaf_table) {
+        hg_assert(leaf_table.num_rows() == (index_t) num_leaves(tree),
+                  "The number of rows of the table must be equal to the number of leaves of the tree.");
+
+        sparse_intersection_table_internal::sparse_intersection_table_builder<value_t> builder(
+                (index_t) num_vertices(tree), leaf_table.num_columns);
+
+        for (auto i: leaves_iterator(tree)) {
+            for (index_t k = leaf_table.row_begin(i); k < leaf_table.row_begin(i + 1); k++) {
+                builder.add(leaf_table.columns(k), leaf_table.values(k));
+            }
+            builder.close_row();
+        }
+
+        // children are closed before their parent
+        for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
+            for (auto c: children_iterator(i, tree)) {
+                for (index_t k = builder.row_begin(c); k < builder.row_begin(c + 1); k++) {
+                    auto entry = builder.entry(k);
+                    builder.add(entry.first, entry.second);
+                }
+            }
+            builder.close_row();
+        }
+        return builder.finalize();
+    }
+}
@@ -14,6 +14,7 @@
 #include "details/graph_concepts.hpp"
 #include "details/indexed_edge.hpp"
 #include "higra/structure/details/iterators.hpp"
+#include "result_cache.hpp"
 #include <vector>
 #include <list>
 #include <unordered_set>
@@ -138,6 +139,7 @@ namespace hg {
                 auto tmp = _num_vertices;
                 _num_vertices++;
                 out_edges.emplace_back();
+                _identity.modified();
                 return tmp;
             }
 
@@ -145,6 +147,7 @@ namespace hg {
                 if(num > 0) {
                     _num_vertices += num;
                     out_edges.resize(_num_vertices);
+                    _identity.modified();
                 }
             }
 
@@ -156,6 +159,7 @@ namespace hg {
                     remove_from_container(out_edges[target], ei);
                 edges[ei].source = invalid_index;
                 edges[ei].target = invalid_index;
+                _identity.modified();
             }
 
             void set_edge(edge_index_t ei, vertex_descriptor v1, vertex_descriptor v2) {
@@ -170,6 +174,7 @@ namespace hg {
                     add_to_container(out_edges[v2], ei);
                 edges[ei].source = v1;
                 edges[ei].target = v2;
+                _identity.modified();
             }
 
             const auto &edge_from_index(index_t v) const {
@@ -203,6 +208,7 @@ namespace hg {
                 add_to_container(out_edges[v1], index);
                 if (v1 != v2)
                     add_to_container(out_edges[v2], index);
+                _identity.modified();
 
                 return edges[index];
             }
@@ -212,11 +218,21 @@ namespace hg {
                 return add_edge(e.first, e.second);
             }
 
+            /**
+             * Identity of the graph in the result cache (see result_cache.hpp): it is updated by each
+             * modification of the graph
+             * @return
+             */
+            const cache_identity &identity() const {
+                return _identity;
+            }
+
         private:
 
             size_t _num_vertices;
             std::vector<edge_descriptor> edges;
             std::vector<out_edge_container_type> out_edges; // same as in_edges...
+            cache_identity _identity;
 
         };
 
@@ -29,8 +29,15 @@ namespace hg {
 
     /**
      * Preferred type to represent an index
+     *
+     * If HG_USE_32BIT_INDEX is defined, indices are represented on 32 bits: this halves the memory footprint of trees,
+     * graphs and hierarchies but limits the number of elements (vertices, edges...) to 2^31 - 1.
      */
+#ifdef HG_USE_32BIT_INDEX
+    using index_t = int32_t;
+#else
     using index_t = int64_t;
+#endif
 
     /**
      * Constant used to represent an invalid index (eg. not initialized)
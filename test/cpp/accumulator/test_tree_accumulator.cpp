@@ -10,7 +10,10 @@
 
 #include "../test_utils.hpp"
 #include "higra/accumulator/tree_accumulator.hpp"
+#include "xtensor/xrandom.hpp"
 #include <functional>
+#include <numeric>
+#include <random>
 
 
 using namespace hg;
@@ -47,6 +50,11 @@ namespace tree_accumulator {
         array_1d<index_t> ref3{1, 1, 1, 1, 1, 2, 2, 3};
         REQUIRE(xt::allclose(ref3, res3));
 
+        array_1d<double> vertex_data2{1, 2, 3, 4, 5};
+        auto res4 = accumulate_sequential(tree, vertex_data2, hg::accumulator_mean());
+        array_1d<double> ref4{1, 2, 3, 4, 5, 1.5, 4, 2.75};
+        REQUIRE(xt::allclose(ref4, res4));
+
     }
 
     TEST_CASE("accumulator tree vectorial", "[tree_accumulator]") {
@@ -183,4 +191,85 @@ namespace tree_accumulator {
                            {8,  1}};
         REQUIRE(xt::allclose(ref4, output4));
     }
-}
\ No newline at end of file
+
+    hg::tree random_tree(index_t num_leaves) {
+        // merge 2 or 3 random nodes until a single node remains
+        std::vector<index_t> active(num_leaves);
+        std::iota(active.begin(), active.end(), 0);
+        std::vector<index_t> parents(num_leaves, -1);
+        std::mt19937 generator(42);
+        while (active.size() > 1) {
+            index_t num_children = (std::min)((index_t) active.size(), (index_t) (2 + generator() % 2));
+            index_t new_node = parents.size();
+            parents.push_back(-1);
+            for (index_t i = 0; i < num_children; i++) {
+                index_t pos = generator() % active.size();
+                parents[active[pos]] = new_node;
+                active[pos] = active.back();
+                active.pop_back();
+            }
+            active.push_back(new_node);
+        }
+        parents.back() = parents.size() - 1;
+        array_1d<index_t> parents_array = xt::zeros<index_t>({parents.size()});
+        std::copy(parents.begin(), parents.end(), parents_array.begin());
+        return hg::tree(parents_array);
+    }
+
+    TEST_CASE("accumulator tree multithreaded", "[tree_accumulator]") {
+        auto tree = random_tree(10000);
+        auto sequential = tree_accumulator_execution::sequential;
+        auto multithreaded = tree_accumulator_execution::multithreaded;
+        xt::random::seed(42);
+        array_1d<double> input = xt::random::rand<double>({num_vertices(tree)});
+        array_1d<double> vertex_data = xt::random::rand<double>({num_leaves(tree)});
+        array_2d<double> input2 = xt::random::rand<double>({num_vertices(tree), (size_t) 3});
+        array_2d<double> vertex_data2 = xt::random::rand<double>({num_leaves(tree), (size_t) 3});
+
+        REQUIRE((accumulate_parallel(tree, input, accumulator_sum(), sequential) ==
+                 accumulate_parallel(tree, input, accumulator_sum(), multithreaded)));
+        REQUIRE((accumulate_parallel(tree, input2, accumulator_min(), sequential) ==
+                 accumulate_parallel(tree, input2, accumulator_min(), multithreaded)));
+        REQUIRE((accumulate_parallel(tree, input, accumulator_counter(), sequential) ==
+                 accumulate_parallel(tree, input, accumulator_counter(), multithreaded)));
+
+        REQUIRE((accumulate_sequential(tree, vertex_data, accumulator_sum(), sequential) ==
+                 accumulate_sequential(tree, vertex_data, accumulator_sum(), multithreaded)));
+        REQUIRE((accumulate_sequential(tree, vertex_data2, accumulator_max(), sequential) ==
+                 accumulate_sequential(tree, vertex_data2, accumulator_max(), multithreaded)));
+        REQUIRE((accumulate_sequential(tree, vertex_data2, accumulator_mean(), sequential) ==
+                 accumulate_sequential(tree, vertex_data2, accumulator_mean(), multithreaded)));
+
+        REQUIRE((accumulate_and_combine_sequential(tree, input, vertex_data, accumulator_max(),
+                                                   std::plus<double>(), sequential) ==
+                 accumulate_and_combine_sequential(tree, input, vertex_data, accumulator_max(),
+                                                   std::plus<double>(), multithreaded)));
+        REQUIRE((accumulate_and_combine_sequential(tree, input2, vertex_data2, accumulator_sum(),
+                                                   std::multiplies<double>(), sequential) ==
+                 accumulate_and_combine_sequential(tree, input2, vertex_data2, accumulator_sum(),
+                                                   std::multiplies<double>(), multithreaded)));
+    }
+
+    TEST_CASE("propagate tree multithreaded", "[tree_accumulator]") {
+        auto tree = random_tree(10000);
+        auto sequential = tree_accumulator_execution::sequential;
+        auto multithreaded = tree_accumulator_execution::multithreaded;
+        xt::random::seed(42);
+        array_1d<double> input = xt::random::rand<double>({num_vertices(tree)});
+        array_2d<double> input2 = xt::random::rand<double>({num_vertices(tree), (size_t) 3});
+        array_1d<bool> condition = xt::random::randint<int>({num_vertices(tree)}, 0, 2);
+
+        REQUIRE((propagate_parallel(tree, input, sequential) ==
+                 propagate_parallel(tree, input, multithreaded)));
+        REQUIRE((propagate_parallel(tree, input2, condition, sequential) ==
+                 propagate_parallel(tree, input2, condition, multithreaded)));
+        REQUIRE((propagate_sequential(tree, input, condition, sequential) ==
+                 propagate_sequential(tree, input, condition, multithreaded)));
+        REQUIRE((propagate_sequential(tree, input2, condition, sequential) ==
+                 propagate_sequential(tree, input2, condition, multithreaded)));
+        REQUIRE((propagate_sequential_and_accumulate(tree, input, accumulator_sum(), sequential) ==
+                 propagate_sequential_and_accumulate(tree, input, accumulator_sum(), multithreaded)));
+        REQUIRE((propagate_sequential_and_accumulate(tree, input2, accumulator_max(), sequential) ==
+                 propagate_sequential_and_accumulate(tree, input2, accumulator_max(), multithreaded)));
+    }
+}
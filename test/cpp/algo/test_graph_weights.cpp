@@ -11,6 +11,7 @@
 #include "higra/image/graph_image.hpp"
 #include "higra/algo/graph_weights.hpp"
 #include "../test_utils.hpp"
+#include "xtensor/xrandom.hpp"
 
 
 using namespace hg;
@@ -99,4 +100,72 @@ namespace test_graph_weights {
         auto r8 = weight_graph(g, data2, hg::weight_functions::L0);
         REQUIRE(xt::allclose(ref8, r8));
     }
+
+    TEST_CASE("graph edge weighting grid graph", "[graph_weights]") {
+        std::vector<weight_functions> scalar_functions{weight_functions::mean,
+                                                       weight_functions::min,
+                                                       weight_functions::max,
+                                                       weight_functions::source,
+                                                       weight_functions::target};
+        std::vector<weight_functions> vectorial_functions{weight_functions::L0,
+                                                          weight_functions::L1,
+                                                          weight_functions::L2,
+                                                          weight_functions::L_infinity,
+                                                          weight_functions::L2_squared};
+        std::vector<point_2d_i> neighbours{{{-2, 1}},
+                                           {{-1, -3}},
+                                           {{0,  -2}},
+                                           {{0,  2}},
+                                           {{1,  3}},
+                                           {{2,  -1}}};
+        std::vector<std::vector<index_t>> shapes{{1, 1},
+                                                 {1, 7},
+                                                 {5, 1},
+                                                 {4, 5},
+                                                 {13, 8}};
+        xt::random::seed(1);
+        for (auto &shape: shapes) {
+            embedding_grid_2d embedding(shape);
+            std::vector<std::pair<grid_graph_2d, ugraph>> graphs{
+                    {get_4_adjacency_grid_graph(embedding), get_4_adjacency_graph(embedding)},
+                    {get_8_adjacency_grid_graph(embedding), get_8_adjacency_graph(embedding)},
+                    {grid_graph_2d(embedding, neighbours),
+                     copy_graph(regular_grid_graph_2d(embedding, neighbours))}};
+            index_t num_v = embedding.size();
+            array_1d<int> scalar_data = xt::random::randint<int>({num_v}, 0, 4);
+            array_2d<int> vectorial_data = xt::random::randint<int>({num_v, (index_t) 3}, 0, 4);
+
+            for (auto &graphs_pair: graphs) {
+                auto &g = graphs_pair.first;
+                auto &gref = graphs_pair.second;
+                for (auto f: scalar_functions) {
+                    auto r = weight_graph(g, scalar_data, f);
+                    auto ref = weight_graph(gref, scalar_data, f);
+                    REQUIRE((r == ref));
+                }
+                for (auto f: vectorial_functions) {
+                    auto r = weight_graph(g, scalar_data, f);
+                    auto ref = weight_graph(gref, scalar_data, f);
+                    REQUIRE((r == ref));
+                    auto rv = weight_graph(g, vectorial_data, f);
+                    auto refv = weight_graph(gref, vectorial_data, f);
+                    REQUIRE((rv == refv));
+                }
+            }
+        }
+    }
+
+    TEST_CASE("graph edge weighting vectorial 3d weights", "[graph_weights]") {
+        auto g = get_4_adjacency_graph({2, 2});
+        xt::xtensor<double, 3> data{{{0, 1}, {1, 0}},
+                                    {{2, 3}, {0, 0}},
+                                    {{4, 5}, {1, 0}},
+                                    {{6, 7}, {0, 0}}};
+        array_1d<double> ref1{5, 8, 8, 5};
+        auto r1 = weight_graph(g, data, hg::weight_functions::L1);
+        REQUIRE((r1 == ref1));
+
+        auto r2 = weight_graph(g, xt::transpose(xt::transpose(data)), hg::weight_functions::L1);
+        REQUIRE((r2 == ref1));
+    }
 }
@@ -223,7 +223,7 @@ namespace test_linear_energy_function_optimization {
                 edge_length);
         auto &tree = res.tree;
         auto &altitudes = res.altitudes;
-        array_1d<index_t> ref_parents{10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16};
+        array_1d<index_t> ref_parents{9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16};
         array_1d<double> ref_altitudes{0., 0., 0.,
                                        0., 0., 0.,
                                        0., 0., 0.,
@@ -252,7 +252,7 @@ namespace test_linear_energy_function_optimization {
         auto &tree = res.tree;
         auto &altitudes = res.altitudes;
 
-        array_1d<index_t> ref_parents{10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16};
+        array_1d<index_t> ref_parents{9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16};
         array_1d<double> ref_altitudes{0., 0., 0.,
                                        0., 0., 0.,
                                        0., 0., 0.,
@@ -10,7 +10,10 @@
 
 #include "../test_utils.hpp"
 #include "higra/detail/log.hpp"
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace test_log {
 
@@ -32,4 +35,38 @@ namespace test_log {
         loggers.clear();
         loggers.push_back(save);
     }
-}
\ No newline at end of file
+
+    TEST_CASE("test logger concurrent emit", "[logger]") {
+        auto save = logger::callbacks();
+        std::atomic<int> count{0};
+        {
+            std::lock_guard<std::mutex> lock(logger::callbacks_mutex());
+            logger::callbacks().clear();
+            logger::callbacks().push_back([&count](const std::string &msg) {
+                if (msg.find("concurrent") != std::string::npos) {
+                    count++;
+                }
+            });
+        }
+
+        const int num_threads = 4;
+        const int num_messages = 100;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < num_threads; t++) {
+            threads.emplace_back([]() {
+                for (int i = 0; i < num_messages; i++) {
+                    HG_LOG_WARNING("%s %d", "concurrent", i);
+                }
+            });
+        }
+        for (auto &t: threads) {
+            t.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(logger::callbacks_mutex());
+            logger::callbacks() = save;
+        }
+        REQUIRE(count == num_threads * num_messages);
+    }
+}
@@ -234,4 +234,50 @@ namespace binary_partition_tree {
         REQUIRE(r3.tree.parents() == r3_ref.tree.parents());
     }
 
+    TEST_CASE("reciprocal nearest neighbours simple", "[binary_partition_tree]") {
+        auto graph = get_4_adjacency_graph({3, 3});
+        array_1d<double> edge_weights({1, 7, 2, 10, 16, 3, 11, 4, 12, 14, 5, 6});
+        array_1d<double> edge_weight_weights({7, 1, 7, 3, 2, 8, 2, 2, 2, 1, 5, 9});
+
+        auto res1 = binary_partition_tree_complete_linkage(graph, edge_weights,
+                                                           bpt_linkage_algorithm::reciprocal_nearest_neighbours);
+        array_1d<index_t> expected_parents1({9, 9, 10, 11, 11, 12, 13, 13, 14, 10, 16, 12, 15, 14, 15, 16, 16});
+        array_1d<double> expected_levels1({0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 14, 16});
+        REQUIRE((expected_parents1 == res1.tree.parents()));
+        REQUIRE((expected_levels1 == res1.altitudes));
+
+        auto res2 = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights,
+                                                          bpt_linkage_algorithm::reciprocal_nearest_neighbours);
+        array_1d<index_t> expected_parents2({9, 9, 10, 11, 11, 12, 13, 13, 14, 10, 15, 12, 15, 14, 16, 16, 16});
+        array_1d<double> expected_levels2({0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 11.5, 12});
+        REQUIRE((expected_parents2 == res2.tree.parents()));
+        REQUIRE((expected_levels2 == res2.altitudes));
+    }
+
+    TEST_CASE("reciprocal nearest neighbours equiv heap", "[binary_partition_tree]") {
+        xt::random::seed(12);
+        for (index_t i = 0; i < 10; i++) {
+            auto graph = get_4_adjacency_graph({20, 25});
+            for (index_t j = 0; j < 100; j++) { // additional long range edges
+                auto s = xt::random::randint<index_t>({2}, 0, num_vertices(graph));
+                if (s(0) != s(1)) {
+                    add_edge(s(0), s(1), graph);
+                }
+            }
+            array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+            array_1d<double> edge_weight_weights = xt::random::randint<int>({num_edges(graph)}, 1, 10);
+
+            auto r1 = binary_partition_tree_complete_linkage(graph, edge_weights);
+            auto r1_rnn = binary_partition_tree_complete_linkage(graph, edge_weights,
+                                                                 bpt_linkage_algorithm::reciprocal_nearest_neighbours);
+            REQUIRE((r1.tree.parents() == r1_rnn.tree.parents()));
+            REQUIRE((r1.altitudes == r1_rnn.altitudes));
+
+            auto r2 = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+            auto r2_rnn = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights,
+                                                                bpt_linkage_algorithm::reciprocal_nearest_neighbours);
+            REQUIRE((r2.tree.parents() == r2_rnn.tree.parents()));
+            REQUIRE(xt::allclose(r2.altitudes, r2_rnn.altitudes));
+        }
+    }
 }
@@ -14,6 +14,7 @@
 #include "higra/image/graph_image.hpp"
 #include "higra/algo/tree.hpp"
 #include "xtensor/xadapt.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 using namespace std;
@@ -38,6 +39,45 @@ namespace binary_partition_tree {
         REQUIRE((expected_parents == parents));
     }
 
+    TEST_CASE("test canonized_tree_construction_parallel", "[component_tree]") {
+        xt::random::seed(42);
+        vector<ugraph> graphs{get_4_adjacency_graph({37, 41}), get_8_adjacency_graph({23, 19})};
+        // disconnected graph
+        ugraph g(50);
+        for (index_t i = 0; i < 49; i++) {
+            if (i % 10 != 9) {
+                add_edge(i, i + 1, g);
+            }
+            if (i % 7 == 0) {
+                add_edge(i, 49 - i, g);
+            }
+        }
+        graphs.push_back(g);
+
+        for (const auto &graph: graphs) {
+            for (int num_levels: {2, 8, 1000}) {
+                array_1d<int> vertex_weights = xt::random::randint<int>({num_vertices(graph)}, 0, num_levels);
+                array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights);
+                auto expected_parents = component_tree_internal::pre_tree_construction(graph, sorted_vertex_indices);
+                component_tree_internal::canonize_tree(expected_parents, vertex_weights, sorted_vertex_indices);
+                array_1d<index_t> ranks = array_1d<index_t>::from_shape({num_vertices(graph)});
+                for (index_t i = 0; i < (index_t) num_vertices(graph); i++) {
+                    ranks(sorted_vertex_indices(i)) = i;
+                }
+                for (index_t chunk_size: {1, 2, 7, 64, 100, 10000}) {
+                    auto parents = component_tree_internal::chunked_canonized_tree_construction(
+                            graph, vertex_weights, sorted_vertex_indices, ranks, chunk_size);
+                    REQUIRE((expected_parents == parents));
+                    for (index_t num_bands: {1, 3, 256}) {
+                        auto parents2 = component_tree_internal::canonized_tree_construction_parallel(
+                                graph, vertex_weights, sorted_vertex_indices, chunk_size, num_bands);
+                        REQUIRE((expected_parents == parents2));
+                    }
+                }
+            }
+        }
+    }
+
     TEST_CASE("test canonize_tree", "[component_tree]") {
         auto graph = get_4_adjacency_implicit_graph({4, 4});
         array_1d<double> vertex_weights({0, 1, 4, 4,
@@ -126,6 +166,10 @@ namespace binary_partition_tree {
                                              6., 5., 4., 3., 2.,
                                              1., 0.});
         REQUIRE((expected_altitudes == altitudes));
+
+        auto res2 = component_tree_max_tree(graph, vertex_weights, component_tree_algorithm::parallel);
+        REQUIRE((expected_parents == res2.tree.parents()));
+        REQUIRE((expected_altitudes == res2.altitudes));
     }
 
     TEST_CASE("test min tree", "[component_tree]") {
@@ -158,6 +202,10 @@ namespace binary_partition_tree {
                                              1., 0.});
         expected_altitudes *= -1.;
         REQUIRE((expected_altitudes == altitudes));
+
+        auto res2 = component_tree_min_tree(graph, vertex_weights, component_tree_algorithm::parallel);
+        REQUIRE((expected_parents == res2.tree.parents()));
+        REQUIRE((expected_altitudes == res2.altitudes));
     }
 
     TEST_CASE("test max tree area filter", "[component_tree]") {
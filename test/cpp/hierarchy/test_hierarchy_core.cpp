@@ -82,6 +82,88 @@ namespace hierarchy_core {
         REQUIRE((mst_edge_map == array_1d<int>({1, 0, 3, 4, 2})));
     }
 
+    template<typename graph_t, typename T>
+    void check_bpt_canonical_algorithms(const graph_t &graph, const T &edge_weights) {
+        auto res_k = bpt_canonical(graph, edge_weights, bpt_algorithm::kruskal);
+        auto res_b = bpt_canonical(graph, edge_weights, bpt_algorithm::boruvka);
+        auto res_a = bpt_canonical(graph, edge_weights);
+
+        for (auto *res: {&res_b, &res_a}) {
+            REQUIRE((hg::parents(res->tree) == hg::parents(res_k.tree)));
+            REQUIRE((res->altitudes == res_k.altitudes));
+            REQUIRE((res->mst_edge_map == res_k.mst_edge_map));
+            REQUIRE(num_edges(res->mst) == num_edges(res_k.mst));
+            for (index_t i = 0; i < (index_t) num_edges(res_k.mst); i++) {
+                REQUIRE(edge_from_index(i, res->mst) == edge_from_index(i, res_k.mst));
+            }
+        }
+    }
+
+    TEST_CASE("canonical binary partition tree algorithms", "[hierarchy_core]") {
+        xt::random::seed(42);
+
+        auto graph = get_4_adjacency_graph({2, 3});
+        array_1d<double> edge_weights{1, 0, 2, 1, 1, 1, 2};
+        check_bpt_canonical_algorithms(graph, edge_weights);
+
+        // many ties
+        auto graph2 = get_8_adjacency_graph({37, 53});
+        array_1d<int> edge_weights2 = xt::random::randint<int>({num_edges(graph2)}, 0, 5);
+        check_bpt_canonical_algorithms(graph2, edge_weights2);
+
+        array_1d<double> edge_weights3 = xt::random::rand<double>({num_edges(graph2)});
+        check_bpt_canonical_algorithms(graph2, edge_weights3);
+
+        // constant weights
+        array_1d<float> edge_weights4 = xt::ones<float>({num_edges(graph2)});
+        check_bpt_canonical_algorithms(graph2, edge_weights4);
+
+        // random graph with multiple edges and self loops
+        ugraph graph5(100);
+        for (index_t i = 1; i < 100; i++) {
+            graph5.add_edge(i - 1, i);
+        }
+        array_1d<index_t> sources = xt::random::randint<index_t>({500}, 0, 100);
+        array_1d<index_t> targets = xt::random::randint<index_t>({500}, 0, 100);
+        add_edges(sources, targets, graph5);
+        array_1d<int> edge_weights5 = xt::random::randint<int>({num_edges(graph5)}, 0, 10);
+        check_bpt_canonical_algorithms(graph5, edge_weights5);
+    }
+
+    TEST_CASE("canonical binary partition tree boruvka non connected graph", "[hierarchy_core]") {
+        ugraph graph(4);
+        graph.add_edge(0, 1);
+        graph.add_edge(2, 3);
+        array_1d<double> edge_weights{1, 2};
+        REQUIRE_THROWS(bpt_canonical(graph, edge_weights, bpt_algorithm::boruvka));
+    }
+
+
+    TEST_CASE("canonical binary partition tree edge list", "[hierarchy_core]") {
+        xt::random::seed(42);
+        auto graph = get_8_adjacency_graph({17, 23});
+        array_1d<int> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 5);
+
+        auto res = bpt_canonical(graph, edge_weights);
+        auto res_el = bpt_canonical_edge_list(graph, edge_weights);
+        REQUIRE((hg::parents(res_el.tree) == hg::parents(res.tree)));
+        REQUIRE((res_el.altitudes == res.altitudes));
+        REQUIRE((res_el.mst_edge_map == res.mst_edge_map));
+        REQUIRE(res_el.mst.sources.size() == num_edges(res.mst));
+        for (index_t i = 0; i < (index_t) num_edges(res.mst); i++) {
+            auto e = edge_from_index(i, res.mst);
+            REQUIRE(res_el.mst.sources(i) == source(e, res.mst));
+            REQUIRE(res_el.mst.targets(i) == target(e, res.mst));
+        }
+
+        // bpt of the mst with new weights
+        array_1d<double> mst_edge_weights = xt::random::rand<double>({num_edges(res.mst)});
+        auto res2 = bpt_canonical(res.mst, mst_edge_weights);
+        auto res2_el = bpt_canonical_edge_list(num_vertices(graph), res_el.mst, mst_edge_weights);
+        REQUIRE((hg::parents(res2_el.tree) == hg::parents(res2.tree)));
+        REQUIRE((res2_el.altitudes == res2.altitudes));
+        REQUIRE((res2_el.mst_edge_map == res2.mst_edge_map));
+    }
 
     TEST_CASE("simplify tree", "[hierarchy_core]") {
 
@@ -0,0 +1,74 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "../test_utils.hpp"
+#include "higra/hierarchy/tiled_watershed_hierarchy.hpp"
+#include "higra/image/graph_image.hpp"
+#include "xtensor/xrandom.hpp"
+
+namespace tiled_watershed_hierarchy {
+
+    using namespace hg;
+    using namespace std;
+
+    TEST_CASE("tiled bpt canonical", "[tiled_watershed_hierarchy]") {
+        embedding_grid_2d embedding{23, 31};
+        auto graph = get_4_adjacency_graph(embedding);
+        xt::random::seed(1);
+        // few distinct values: many ties
+        array_1d<int> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 5);
+        auto reader = make_array_tile_reader(embedding, edge_weights);
+
+        auto ref = bpt_canonical(graph, edge_weights);
+
+        vector<pair<index_t, index_t>> tile_sizes{{1,  1},
+                                                  {4,  7},
+                                                  {23, 5},
+                                                  {10, 100},
+                                                  {100, 100}};
+        for (auto &ts: tile_sizes) {
+            auto res = tiled_bpt_canonical(reader, ts.first, ts.second);
+            REQUIRE((res.tree.parents() == ref.tree.parents()));
+            REQUIRE((res.altitudes == ref.altitudes));
+            REQUIRE((res.mst_edge_map == ref.mst_edge_map));
+        }
+    }
+
+    TEST_CASE("tiled watershed hierarchies", "[tiled_watershed_hierarchy]") {
+        embedding_grid_2d embedding{37, 29};
+        auto graph = get_4_adjacency_graph(embedding);
+        xt::random::seed(2);
+        array_1d<double> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 10);
+        auto reader = make_array_tile_reader(embedding, edge_weights);
+
+        auto ref_area = watershed_hierarchy_by_area(graph, edge_weights);
+        auto ref_volume = watershed_hierarchy_by_volume(graph, edge_weights);
+        auto ref_dynamics = watershed_hierarchy_by_dynamics(graph, edge_weights);
+
+        auto area = tiled_watershed_hierarchy_by_area(reader, 8, 6);
+        REQUIRE((area.tree.parents() == ref_area.tree.parents()));
+        REQUIRE((area.altitudes == ref_area.altitudes));
+
+        auto volume = tiled_watershed_hierarchy_by_volume(reader, 8, 6);
+        REQUIRE((volume.tree.parents() == ref_volume.tree.parents()));
+        REQUIRE((volume.altitudes == ref_volume.altitudes));
+
+        auto dynamics = tiled_watershed_hierarchy_by_dynamics(reader, 8, 6);
+        REQUIRE((dynamics.tree.parents() == ref_dynamics.tree.parents()));
+        REQUIRE((dynamics.altitudes == ref_dynamics.altitudes));
+    }
+
+    TEST_CASE("tiled watershed hierarchy invalid tile size", "[tiled_watershed_hierarchy]") {
+        embedding_grid_2d embedding{3, 3};
+        array_1d<double> edge_weights = xt::zeros<double>({12});
+        auto reader = make_array_tile_reader(embedding, edge_weights);
+        REQUIRE_THROWS(tiled_bpt_canonical(reader, 0, 2));
+    }
+}
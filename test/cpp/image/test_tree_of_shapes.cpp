@@ -13,6 +13,7 @@
 #include "higra/algo/tree.hpp"
 #include "xtensor/xstrided_view.hpp"
 #include "xtensor/xrandom.hpp"
+#include "xtensor/xindex_view.hpp"
 #include "../test_utils.hpp"
 #include <set>
 
@@ -58,6 +59,43 @@ namespace tree_of_shapes {
         }
     }
 
+    TEST_CASE("test hierarchical_bitset", "[tree_of_shapes]") {
+        using hg::tree_of_shapes_internal::hierarchical_bitset;
+
+        index_t size = 64 * 64 * 3 + 5;
+        hierarchical_bitset b(size);
+        REQUIRE(b.size() == size);
+        REQUIRE(b.next(0) == invalid_index);
+        REQUIRE(b.previous(size - 1) == invalid_index);
+
+        std::vector<index_t> elements{0, 63, 64, 4095, 4096, 9000, size - 1};
+        for (auto e: elements) {
+            b.set(e);
+        }
+        for (index_t i = 0; i < size; i++) {
+            REQUIRE(b.test(i) == (std::find(elements.begin(), elements.end(), i) != elements.end()));
+        }
+        REQUIRE(b.next(0) == 0);
+        REQUIRE(b.next(1) == 63);
+        REQUIRE(b.next(65) == 4095);
+        REQUIRE(b.next(4097) == 9000);
+        REQUIRE(b.next(9001) == size - 1);
+        REQUIRE(b.previous(size - 2) == 9000);
+        REQUIRE(b.previous(8999) == 4096);
+        REQUIRE(b.previous(4094) == 64);
+        REQUIRE(b.previous(62) == 0);
+
+        b.reset(4095);
+        b.reset(4096);
+        REQUIRE(!b.test(4096));
+        REQUIRE(b.next(65) == 9000);
+        REQUIRE(b.previous(8999) == 64);
+        b.reset(0);
+        REQUIRE(b.previous(62) == invalid_index);
+        b.reset(size - 1);
+        REQUIRE(b.next(9001) == invalid_index);
+    }
+
     TEST_CASE("test interpolate_plain_map_khalimsky2d", "[tree_of_shapes]") {
         array_1d<int> image{1, 1, 1, 1, 1, 1,
                             1, 0, 0, 3, 3, 1,
@@ -399,4 +437,19 @@ TEST_CASE("test tree of shapes self duality", "[tree_of_shapes]") {
     REQUIRE(test_tree_isomorphism(res1.tree, res2.tree));
 }
 
+TEST_CASE("test tree of shapes integer and rank transform equivalence", "[tree_of_shapes]") {
+    xt::random::seed(42);
+    array_2d<unsigned char> image = xt::random::randint<unsigned char>({37, 29}, 0, 255);
+    // zero padding: the mean padding value is rounded for integer images
+    auto res1 = component_tree_tree_of_shapes_image2d(image, tos_padding::zero);
+    auto res2 = component_tree_tree_of_shapes_image2d(xt::eval(xt::cast<float>(image)), tos_padding::zero);
+    REQUIRE(test_tree_isomorphism(res1.tree, res2.tree));
+    // leaves are the pixels of the image in both trees
+    array_1d<float> leaf_altitudes1 = xt::index_view(
+            res1.altitudes, xt::view(res1.tree.parents(), xt::range(0, num_leaves(res1.tree))));
+    array_1d<float> leaf_altitudes2 = xt::index_view(
+            res2.altitudes, xt::view(res2.tree.parents(), xt::range(0, num_leaves(res2.tree))));
+    REQUIRE((leaf_altitudes1 == leaf_altitudes2));
+}
+
 }
@@ -0,0 +1,59 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/io/tile_reader.hpp"
+#include "higra/image/graph_image.hpp"
+#include "../test_utils.hpp"
+#include <cstdio>
+#include <fstream>
+
+namespace test_tile_reader {
+
+    using namespace hg;
+    using namespace std;
+
+    TEST_CASE("array tile reader", "[tile_reader]") {
+        embedding_grid_2d embedding{3, 4};
+        auto graph = get_4_adjacency_graph(embedding);
+        array_1d<double> edge_weights = xt::arange<double>(num_edges(graph));
+        auto reader = make_array_tile_reader(embedding, edge_weights);
+
+        auto tile = reader.read_tile(0, 0, 3, 4);
+        for (auto e: edge_iterator(graph)) {
+            auto s = source(e, graph);
+            auto t = target(e, graph);
+            index_t c = (t == s + 1) ? 0 : 1;
+            REQUIRE(tile(s / 4, s % 4, c) == edge_weights(index(e, graph)));
+        }
+
+        auto tile2 = reader.read_tile(1, 2, 2, 2);
+        REQUIRE((tile2 == xt::view(tile, xt::range(1, 3), xt::range(2, 4), xt::all())));
+
+        REQUIRE_THROWS(make_array_tile_reader(embedding, xt::eval(xt::zeros<double>({10}))));
+    }
+
+    TEST_CASE("raw file tile reader", "[tile_reader]") {
+        embedding_grid_2d embedding{5, 3};
+        array_3d<float> data = xt::reshape_view(xt::arange<float>(5 * 3 * 2), {5, 3, 2});
+        string filename = "test_tile_reader.raw";
+        {
+            ofstream out(filename, ios::binary);
+            out.write("head", 4);
+            out.write((const char *) data.data(), data.size() * sizeof(float));
+        }
+        {
+            raw_file_tile_reader<float> reader(filename, embedding, 4);
+            REQUIRE((reader.read_tile(0, 0, 5, 3) == data));
+            REQUIRE((reader.read_tile(2, 1, 2, 2) == xt::view(data, xt::range(2, 4), xt::range(1, 3), xt::all())));
+        }
+        REQUIRE_THROWS(raw_file_tile_reader<float>(filename, embedding_grid_2d{6, 3}, 4));
+        remove(filename.c_str());
+    }
+}
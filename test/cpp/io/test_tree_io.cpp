@@ -10,6 +10,9 @@
 
 #include "../test_utils.hpp"
 #include "higra/io/tree_io.hpp"
+#include "higra/io/tree_binary_io.hpp"
+#include <cstdio>
+#include <fstream>
 
 namespace tree_io {
 
@@ -40,4 +43,79 @@ namespace tree_io {
             REQUIRE(attributes.count("attr2") == 1);
             REQUIRE(xt::allclose(attributes["attr2"], attr2));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("save and map binary tree", "[tree_io]") {
+        array_1d<index_t> parent{5, 5, 6, 6, 6, 7, 7, 7};
+
+        array_1d<double> attr1{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+        array_1d<int> attr2{8, 7, 6, 5, 4, 3, 2, 1};
+        array_2d<uint8_t> attr3{{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}, {15, 16}};
+        tree t(parent);
+        string filename = "test_tree_binary_io.bin";
+        {
+            ofstream out(filename, ios::binary);
+            save_tree_binary(out, t)
+                    .add_attribute("attr1", attr1)
+                    .add_attribute("attr2", attr2)
+                    .add_attribute("attr3", xt::view(attr3, xt::all(), 0))
+                    .add_attribute("attr4", xt::view(attr3, xt::all(), 1))
+                    .finalize();
+        }
+
+        {
+            mapped_tree_file file(filename);
+            REQUIRE(file.num_vertices() == num_vertices(t));
+            REQUIRE((file.parents() == parent));
+            auto t2 = file.get_tree();
+            REQUIRE((parents(t2) == parent));
+
+            REQUIRE((file.attribute_names() == vector<string>{"attr1", "attr2", "attr3", "attr4"}));
+            REQUIRE(file.has_attribute("attr1"));
+            REQUIRE(!file.has_attribute("attr5"));
+            REQUIRE(file.attribute_dtype("attr1") == tree_binary_dtype::float64);
+            REQUIRE(file.attribute_dtype("attr2") == tree_binary_dtype::int32);
+            REQUIRE(file.attribute_dtype("attr3") == tree_binary_dtype::uint8);
+
+            auto a1 = file.attribute<double>("attr1");
+            REQUIRE((a1 == attr1));
+            REQUIRE((reinterpret_cast<std::size_t>(file.attribute_data("attr1")) % 64 == 0));
+            REQUIRE((file.attribute<int>("attr2") == attr2));
+            REQUIRE((file.attribute<uint8_t>("attr3") == xt::view(attr3, xt::all(), 0)));
+            REQUIRE((file.attribute<uint8_t>("attr4") == xt::view(attr3, xt::all(), 1)));
+            REQUIRE_THROWS(file.attribute<float>("attr1"));
+            REQUIRE_THROWS(file.attribute<double>("attr5"));
+        }
+        remove(filename.c_str());
+    }
+
+    TEST_CASE("binary tree invalid inputs", "[tree_io]") {
+        tree t(array_1d<index_t>{2, 2, 2});
+        string filename = "test_tree_binary_io.bin";
+        {
+            ofstream out(filename, ios::binary);
+            auto saver = save_tree_binary(out, t);
+            saver.add_attribute("a", array_1d<double>{1, 2, 3});
+            REQUIRE_THROWS(saver.add_attribute("a", array_1d<double>{1, 2, 3}));
+            REQUIRE_THROWS(saver.add_attribute("b", array_1d<double>{1, 2}));
+        }
+        {
+            // corrupted parent: node 0 points outside of the tree
+            fstream file(filename, ios::binary | ios::in | ios::out);
+            file.seekp(64);
+            index_t invalid_parent = 10;
+            file.write(reinterpret_cast<const char *>(&invalid_parent), sizeof(index_t));
+        }
+        {
+            mapped_tree_file file(filename);
+            REQUIRE(file.parents()(0) == 10);
+            REQUIRE_THROWS(file.get_tree());
+        }
+        {
+            ofstream out(filename, ios::binary);
+            out << "not a tree file, not a tree file, not a tree file, not a tree file";
+        }
+        REQUIRE_THROWS(mapped_tree_file(filename));
+        remove(filename.c_str());
+        REQUIRE_THROWS(mapped_tree_file(filename));
+    }
+}
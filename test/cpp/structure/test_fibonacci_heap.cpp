@@ -132,70 +132,70 @@ namespace test_fibonacci_heap {
     };
 
     TEST_CASE("memory pool 1 block", "[fibonacci_heap]") {
-        fibonacci_heap_internal::object_pool<hg::index_t> pool;
-        hg::index_t *i1 = pool.allocate();
+        fibonacci_heap_internal::object_pool<int64_t> pool;
+        int64_t *i1 = pool.allocate();
 
-        hg::index_t *i2 = pool.allocate();
+        int64_t *i2 = pool.allocate();
         REQUIRE((i2 - i1) == 1);
-        hg::index_t *i3 = pool.allocate();
+        int64_t *i3 = pool.allocate();
         REQUIRE((i3 - i1) == 2);
-        hg::index_t *i4 = pool.allocate();
+        int64_t *i4 = pool.allocate();
         REQUIRE((i4 - i1) == 3);
 
         pool.free(i3);
 
-        hg::index_t *i5 = pool.allocate();
+        int64_t *i5 = pool.allocate();
         REQUIRE((i5 - i1) == 2);
-        hg::index_t *i6 = pool.allocate();
+        int64_t *i6 = pool.allocate();
         REQUIRE((i6 - i1) == 4);
 
         pool.free(i5);
         pool.free(i4);
 
-        hg::index_t *i7 = pool.allocate();
+        int64_t *i7 = pool.allocate();
         REQUIRE((i7 - i1) == 3);
-        hg::index_t *i8 = pool.allocate();
+        int64_t *i8 = pool.allocate();
         REQUIRE((i8 - i1) == 2);
-        hg::index_t *i9 = pool.allocate();
+        int64_t *i9 = pool.allocate();
         REQUIRE(i9 - i1 == 5);
-        hg::index_t *i10 = pool.allocate();
+        int64_t *i10 = pool.allocate();
         REQUIRE((i10 - i1) == 6);
     }
 
     TEST_CASE("memory pool several blocks", "[fibonacci_heap]") {
-        fibonacci_heap_internal::object_pool<hg::index_t> pool(3);
-        hg::index_t *i1 = pool.allocate();
-        hg::index_t *i2 = pool.allocate();
+        fibonacci_heap_internal::object_pool<int64_t> pool(3);
+        int64_t *i1 = pool.allocate();
+        int64_t *i2 = pool.allocate();
         REQUIRE(i2 - i1 == 1);
-        hg::index_t *i3 = pool.allocate();
+        int64_t *i3 = pool.allocate();
         REQUIRE(i3 - i1 == 2);
 
-        hg::index_t *i4 = pool.allocate();
-        hg::index_t *i5 = pool.allocate();
+        int64_t *i4 = pool.allocate();
+        int64_t *i5 = pool.allocate();
         REQUIRE(i5 - i4 == 1);
-        hg::index_t *i6 = pool.allocate();
+        int64_t *i6 = pool.allocate();
         REQUIRE(i6 - i4 == 2);
 
-        hg::index_t *i7 = pool.allocate();
-        hg::index_t *i8 = pool.allocate();
+        int64_t *i7 = pool.allocate();
+        int64_t *i8 = pool.allocate();
         REQUIRE(i8 - i7 == 1);
 
         pool.free(i6);
         pool.free(i2);
         pool.free(i4);
 
-        hg::index_t *i9 = pool.allocate();
+        int64_t *i9 = pool.allocate();
         REQUIRE(i9 - i4 == 0);
-        hg::index_t *i10 = pool.allocate();
+        int64_t *i10 = pool.allocate();
         REQUIRE(i10 - i1 == 1);
-        hg::index_t *i11 = pool.allocate();
+        int64_t *i11 = pool.allocate();
         REQUIRE(i11 - i4 == 2);
 
-        hg::index_t *i12 = pool.allocate();
+        int64_t *i12 = pool.allocate();
         REQUIRE(i12 - i7 == 2);
 
-        hg::index_t *i13 = pool.allocate();
-        hg::index_t *i14 = pool.allocate();
+        int64_t *i13 = pool.allocate();
+        int64_t *i14 = pool.allocate();
         REQUIRE(i14 - i13 == 1);
     }
 
@@ -0,0 +1,171 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/graph.hpp"
+#include "higra/image/graph_image.hpp"
+#include "higra/algo/graph_weights.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/hierarchy/watershed_hierarchy.hpp"
+#include "xtensor/xrandom.hpp"
+#include "../test_utils.hpp"
+
+namespace grid_graph {
+
+    using namespace hg;
+    using namespace std;
+
+    const std::vector<std::array<index_t, 2>> shapes{{1, 1},
+                                                     {1, 5},
+                                                     {5, 1},
+                                                     {2, 2},
+                                                     {2, 3},
+                                                     {3, 2},
+                                                     {4, 7},
+                                                     {13, 6}};
+
+    template<typename graph_t>
+    auto sorted_out_edges(index_t v, const graph_t &g) {
+        vector<tuple<index_t, index_t, index_t>> res;
+        for (auto e: out_edge_iterator(v, g)) {
+            res.emplace_back(source(e, g), target(e, g), index(e, g));
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    template<typename graph_t>
+    auto sorted_in_edges(index_t v, const graph_t &g) {
+        vector<tuple<index_t, index_t, index_t>> res;
+        for (auto e: in_edge_iterator(v, g)) {
+            res.emplace_back(source(e, g), target(e, g), index(e, g));
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    template<typename graph_t>
+    auto sorted_adjacent_vertices(index_t v, const graph_t &g) {
+        vector<index_t> res;
+        for (auto n: adjacent_vertex_iterator(v, g)) {
+            res.push_back(n);
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    template<typename graph_t1, typename graph_t2>
+    void check_same_graph(const graph_t1 &g, const graph_t2 &gref) {
+        REQUIRE(num_vertices(g) == num_vertices(gref));
+        REQUIRE(num_edges(g) == num_edges(gref));
+
+        for (index_t i = 0; i < (index_t) num_edges(gref); i++) {
+            auto e = edge_from_index(i, g);
+            auto eref = edge_from_index(i, gref);
+            REQUIRE(source(e, g) == source(eref, gref));
+            REQUIRE(target(e, g) == target(eref, gref));
+            REQUIRE(index(e, g) == i);
+        }
+
+        index_t i = 0;
+        for (auto e: edge_iterator(g)) {
+            auto eref = edge_from_index(i, gref);
+            REQUIRE(source(e, g) == source(eref, gref));
+            REQUIRE(target(e, g) == target(eref, gref));
+            REQUIRE(index(e, g) == i);
+            i++;
+        }
+        REQUIRE(i == (index_t) num_edges(gref));
+
+        for (auto v: vertex_iterator(gref)) {
+            REQUIRE(degree(v, g) == degree(v, gref));
+            REQUIRE(sorted_out_edges(v, g) == sorted_out_edges(v, gref));
+            REQUIRE(sorted_in_edges(v, g) == sorted_in_edges(v, gref));
+            REQUIRE(sorted_adjacent_vertices(v, g) == sorted_adjacent_vertices(v, gref));
+        }
+    }
+
+    TEST_CASE("grid graph 4 adjacency", "[grid_graph]") {
+        for (auto &shape: shapes) {
+            embedding_grid_2d embedding(shape);
+            check_same_graph(get_4_adjacency_grid_graph(embedding), get_4_adjacency_graph(embedding));
+        }
+    }
+
+    TEST_CASE("grid graph 8 adjacency", "[grid_graph]") {
+        for (auto &shape: shapes) {
+            embedding_grid_2d embedding(shape);
+            check_same_graph(get_8_adjacency_grid_graph(embedding), get_8_adjacency_graph(embedding));
+        }
+    }
+
+    TEST_CASE("grid graph large neighbourhood", "[grid_graph]") {
+        std::vector<point_2d_i> neighbours{{{-2, 1}},
+                                           {{-1, -3}},
+                                           {{0,  -2}},
+                                           {{0,  2}},
+                                           {{1,  3}},
+                                           {{2,  -1}}};
+        for (auto &shape: shapes) {
+            embedding_grid_2d embedding(shape);
+            grid_graph_2d g(embedding, neighbours);
+            auto gref = copy_graph(regular_grid_graph_2d(embedding, neighbours));
+            check_same_graph(g, gref);
+        }
+    }
+
+    TEST_CASE("grid graph invalid neighbourhood", "[grid_graph]") {
+        embedding_grid_2d embedding{3, 3};
+        std::vector<point_2d_i> non_symmetric{{{0, 1}},
+                                              {{1, 0}}};
+        REQUIRE_THROWS(grid_graph_2d(embedding, non_symmetric));
+        std::vector<point_2d_i> origin{{{0, 0}}};
+        REQUIRE_THROWS(grid_graph_2d(embedding, origin));
+    }
+
+    TEST_CASE("grid graph weight_graph", "[grid_graph]") {
+        embedding_grid_2d embedding{13, 6};
+        auto g = get_8_adjacency_grid_graph(embedding);
+        auto gref = get_8_adjacency_graph(embedding);
+        xt::random::seed(1);
+        array_1d<double> vertex_weights = xt::random::rand<double>({num_vertices(g)});
+
+        for (auto f: {weight_functions::mean, weight_functions::L1, weight_functions::source,
+                      weight_functions::target}) {
+            REQUIRE((weight_graph(g, vertex_weights, f) == weight_graph(gref, vertex_weights, f)));
+        }
+    }
+
+    TEST_CASE("grid graph hierarchies", "[grid_graph]") {
+        embedding_grid_2d embedding{17, 11};
+        auto g = get_4_adjacency_grid_graph(embedding);
+        auto gref = get_4_adjacency_graph(embedding);
+        xt::random::seed(1);
+        array_1d<int> edge_weights = xt::random::randint<int>({num_edges(g)}, 0, 10);
+
+        for (auto algorithm: {bpt_algorithm::kruskal, bpt_algorithm::boruvka}) {
+            auto res = bpt_canonical(g, edge_weights, algorithm);
+            auto res_ref = bpt_canonical(gref, edge_weights, algorithm);
+            REQUIRE((res.tree.parents() == res_ref.tree.parents()));
+            REQUIRE((res.altitudes == res_ref.altitudes));
+            REQUIRE((res.mst_edge_map == res_ref.mst_edge_map));
+            REQUIRE((saliency_map(g, res.tree, res.altitudes) == saliency_map(gref, res.tree, res.altitudes)));
+        }
+
+        auto ws = watershed_hierarchy_by_area(g, edge_weights);
+        auto ws_ref = watershed_hierarchy_by_area(gref, edge_weights);
+        REQUIRE((ws.tree.parents() == ws_ref.tree.parents()));
+        REQUIRE((ws.altitudes == ws_ref.altitudes));
+
+        auto wsd = watershed_hierarchy_by_dynamics(g, edge_weights);
+        auto wsd_ref = watershed_hierarchy_by_dynamics(gref, edge_weights);
+        REQUIRE((wsd.tree.parents() == wsd_ref.tree.parents()));
+        REQUIRE((wsd.altitudes == wsd_ref.altitudes));
+    }
+}
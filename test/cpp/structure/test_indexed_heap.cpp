@@ -0,0 +1,110 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/structure/indexed_heap.hpp"
+#include "../test_utils.hpp"
+#include <random>
+#include <set>
+
+namespace test_indexed_heap {
+
+    using namespace hg;
+    using namespace std;
+
+    TEST_CASE("indexed heap simple", "[indexed_heap]") {
+        indexed_heap<double> heap(6);
+        REQUIRE(heap.empty());
+
+        heap.push(0, 5);
+        heap.push(1, 2);
+        heap.push(2, 7);
+        heap.push(3, 2);
+        heap.push(4, 1);
+        REQUIRE(heap.size() == 5);
+        REQUIRE(heap.contains(3));
+        REQUIRE(!heap.contains(5));
+
+        REQUIRE(heap.top() == 4);
+        REQUIRE(heap.top_value() == 1);
+
+        heap.update(2, 0); // decrease key
+        REQUIRE(heap.top() == 2);
+        heap.update(2, 10); // increase key
+        REQUIRE(heap.top() == 4);
+        heap.erase(4);
+        REQUIRE(!heap.contains(4));
+
+        // ties are broken by key
+        vector<index_t> keys;
+        while (!heap.empty()) {
+            keys.push_back(heap.top());
+            heap.pop();
+        }
+        vector<index_t> expected{1, 3, 0, 2};
+        REQUIRE(keys == expected);
+    }
+
+    template<index_t arity>
+    void test_random_operations() {
+        index_t capacity = 200;
+        indexed_heap<int, arity> heap(capacity);
+        set<pair<int, index_t>> reference;
+        vector<int> values(capacity);
+
+        std::mt19937 gen(1);
+        std::uniform_int_distribution<index_t> key_dis(0, capacity - 1);
+        std::uniform_int_distribution<int> value_dis(0, 50);
+        std::uniform_int_distribution<int> op_dis(0, 3);
+
+        for (index_t i = 0; i < 5000; i++) {
+            auto key = key_dis(gen);
+            auto value = value_dis(gen);
+            switch (op_dis(gen)) {
+                case 0:
+                    if (!heap.contains(key)) {
+                        heap.push(key, value);
+                        values[key] = value;
+                        reference.insert({value, key});
+                    }
+                    break;
+                case 1:
+                    if (heap.contains(key)) {
+                        heap.update(key, value);
+                        reference.erase({values[key], key});
+                        values[key] = value;
+                        reference.insert({value, key});
+                    }
+                    break;
+                case 2:
+                    if (heap.contains(key)) {
+                        heap.erase(key);
+                        reference.erase({values[key], key});
+                    }
+                    break;
+                default:
+                    if (!heap.empty()) {
+                        reference.erase({heap.top_value(), heap.top()});
+                        heap.pop();
+                    }
+            }
+            REQUIRE(heap.size() == reference.size());
+            if (!heap.empty()) {
+                REQUIRE(heap.top() == reference.begin()->second);
+                REQUIRE(heap.top_value() == reference.begin()->first);
+            }
+        }
+    }
+
+    TEST_CASE("indexed heap random operations", "[indexed_heap]") {
+        test_random_operations<2>();
+        test_random_operations<4>();
+        test_random_operations<7>();
+    }
+}
@@ -12,6 +12,8 @@
 #include "higra/graph.hpp"
 #include "higra/image/graph_image.hpp"
 #include "higra/structure/lca_fast.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "xtensor/xrandom.hpp"
 #include "../test_utils.hpp"
 
 namespace lca {
@@ -83,4 +85,42 @@ namespace lca {
         auto l2 = lca3.lca(v1, v2);
         REQUIRE((l2 == ref));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("lca random tree", "[lca]") {
+        xt::random::seed(42);
+        auto g = get_4_adjacency_graph({50, 50});
+        array_1d<double> edge_weights = xt::random::rand<double>({num_edges(g)});
+        auto t = bpt_canonical(g, edge_weights).tree;
+        lca_fast lca(t);
+
+        auto num_v = num_vertices(t);
+        array_1d<index_t> depth = array_1d<index_t>::from_shape({num_v});
+        depth(root(t)) = 0;
+        for (auto i: root_to_leaves_iterator(t, leaves_it::include, root_it::exclude)) {
+            depth(i) = depth(parent(i, t)) + 1;
+        }
+        auto naive_lca = [&t, &depth](index_t n1, index_t n2) {
+            while (depth(n1) > depth(n2)) n1 = parent(n1, t);
+            while (depth(n2) > depth(n1)) n2 = parent(n2, t);
+            while (n1 != n2) {
+                n1 = parent(n1, t);
+                n2 = parent(n2, t);
+            }
+            return n1;
+        };
+
+        array_1d<index_t> v1 = xt::random::randint<index_t>({10000}, 0, num_v);
+        array_1d<index_t> v2 = xt::random::randint<index_t>({10000}, 0, num_v);
+        array_1d<index_t> ref = array_1d<index_t>::from_shape({v1.size()});
+        for (index_t i = 0; i < (index_t) v1.size(); i++) {
+            ref(i) = naive_lca(v1(i), v2(i));
+        }
+        auto res = lca.lca(v1, v2);
+        REQUIRE((res == ref));
+
+        auto res_edges = lca.lca(edge_iterator(g));
+        for (auto e: edge_iterator(g)) {
+            REQUIRE(res_edges(index(e, g)) == naive_lca(source(e, g), target(e, g)));
+        }
+    }
+}
@@ -0,0 +1,231 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/graph.hpp"
+#include "higra/structure/result_cache.hpp"
+#include "higra/structure/lca_fast.hpp"
+#include "higra/attribute/tree_attribute.hpp"
+#include "higra/algo/rag.hpp"
+#include "higra/image/graph_image.hpp"
+#include "../test_utils.hpp"
+
+namespace result_cache_test {
+
+    using namespace hg;
+    using namespace std;
+
+    TEST_CASE("result cache hits and misses", "[result_cache]") {
+        result_cache cache;
+        tree t(array_1d<index_t>{5, 5, 6, 6, 6, 7, 7, 7});
+        index_t num_computations = 0;
+        auto compute = [&num_computations]() {
+            num_computations++;
+            return array_1d<index_t>{1, 2, 3};
+        };
+
+        auto r1 = cache.get_or_compute<array_1d<index_t>>(t, "test", compute);
+        REQUIRE(num_computations == 1);
+        REQUIRE(cache.misses() == 1);
+        REQUIRE(cache.hits() == 0);
+        REQUIRE(cache.num_entries() == 1);
+        REQUIRE(cache.memory_usage() == 3 * sizeof(index_t));
+        REQUIRE((*r1 == array_1d<index_t>{1, 2, 3}));
+
+        auto r2 = cache.get_or_compute<array_1d<index_t>>(t, "test", compute);
+        REQUIRE(num_computations == 1);
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(r1 == r2);
+
+        auto r3 = cache.get_or_compute<array_1d<index_t>>(t, "other", compute);
+        REQUIRE(num_computations == 2);
+        REQUIRE(cache.num_entries() == 2);
+        REQUIRE(r1 != r3);
+
+        REQUIRE(cache.get<array_1d<index_t>>(t, "test") == r1);
+        REQUIRE(cache.get<array_1d<index_t>>(t, "missing") == nullptr);
+
+        cache.reset_statistics();
+        REQUIRE(cache.hits() == 0);
+        REQUIRE(cache.misses() == 0);
+    }
+
+    TEST_CASE("result cache validator", "[result_cache]") {
+        result_cache cache;
+        tree t(array_1d<index_t>{5, 5, 6, 6, 6, 7, 7, 7});
+        index_t parameter = 1;
+        index_t num_computations = 0;
+        auto compute = [&]() {
+            num_computations++;
+            return array_1d<index_t>{parameter};
+        };
+        auto is_valid = [&](const array_1d<index_t> &r) { return r(0) == parameter; };
+
+        cache.get_or_compute<array_1d<index_t>>(t, "test", compute, is_valid);
+        cache.get_or_compute<array_1d<index_t>>(t, "test", compute, is_valid);
+        REQUIRE(num_computations == 1);
+        parameter = 2;
+        auto r = cache.get_or_compute<array_1d<index_t>>(t, "test", compute, is_valid);
+        REQUIRE(num_computations == 2);
+        REQUIRE(cache.num_entries() == 1);
+        REQUIRE((*r)(0) == 2);
+    }
+
+    TEST_CASE("result cache owner lifetime and copies", "[result_cache]") {
+        result_cache cache;
+        index_t num_computations = 0;
+        auto compute = [&num_computations]() {
+            num_computations++;
+            return array_1d<index_t>{1};
+        };
+        {
+            tree t(array_1d<index_t>{5, 5, 6, 6, 6, 7, 7, 7});
+            cache.get_or_compute<array_1d<index_t>>(t, "test", compute);
+
+            // a copy is a different object
+            tree t2 = t;
+            cache.get_or_compute<array_1d<index_t>>(t2, "test", compute);
+            REQUIRE(num_computations == 2);
+            REQUIRE(cache.num_entries() == 2);
+
+            // a moved object keeps its identity
+            tree t3 = std::move(t);
+            cache.get_or_compute<array_1d<index_t>>(t3, "test", compute);
+            REQUIRE(num_computations == 2);
+
+            // the moved-from object has no identity
+            cache.get_or_compute<array_1d<index_t>>(t, "test", compute);
+            REQUIRE(num_computations == 3);
+            REQUIRE(cache.num_entries() == 2);
+        }
+        // entries of destroyed objects are removed at the next insertion
+        tree t4(array_1d<index_t>{2, 2, 2});
+        cache.get_or_compute<array_1d<index_t>>(t4, "test", compute);
+        REQUIRE(cache.num_entries() == 1);
+        REQUIRE(cache.memory_usage() == sizeof(index_t));
+    }
+
+    TEST_CASE("result cache invalidation", "[result_cache]") {
+        result_cache cache;
+        index_t num_computations = 0;
+        auto compute = [&num_computations]() {
+            num_computations++;
+            return array_1d<index_t>{1};
+        };
+
+        ugraph g(3);
+        add_edge(0, 1, g);
+        tree t(array_1d<index_t>{2, 2, 2});
+        cache.get_or_compute<array_1d<index_t>>(g, "test", compute);
+        cache.get_or_compute<array_1d<index_t>>(g, "test2", compute);
+        cache.get_or_compute<array_1d<index_t>>(t, "test", compute);
+        REQUIRE(num_computations == 3);
+
+        // modifying a graph invalidates its results
+        add_edge(1, 2, g);
+        cache.get_or_compute<array_1d<index_t>>(g, "test", compute);
+        REQUIRE(num_computations == 4);
+        cache.get_or_compute<array_1d<index_t>>(g, "test", compute);
+        REQUIRE(num_computations == 4);
+
+        cache.invalidate(g);
+        REQUIRE(cache.num_entries() == 1);
+        cache.get_or_compute<array_1d<index_t>>(g, "test", compute);
+        REQUIRE(num_computations == 5);
+
+        cache.clear();
+        REQUIRE(cache.num_entries() == 0);
+        REQUIRE(cache.memory_usage() == 0);
+        cache.get_or_compute<array_1d<index_t>>(t, "test", compute);
+        REQUIRE(num_computations == 6);
+    }
+
+    TEST_CASE("result cache memory limit", "[result_cache]") {
+        result_cache cache(10 * sizeof(index_t));
+        tree t(array_1d<index_t>{2, 2, 2});
+        auto compute = []() { return array_1d<index_t>::from_shape({4}); };
+
+        auto r1 = cache.get_or_compute<array_1d<index_t>>(t, "1", compute);
+        cache.get_or_compute<array_1d<index_t>>(t, "2", compute);
+        // "1" becomes the most recently used entry
+        cache.get_or_compute<array_1d<index_t>>(t, "1", compute);
+        cache.get_or_compute<array_1d<index_t>>(t, "3", compute);
+        REQUIRE(cache.num_entries() == 2);
+        REQUIRE(cache.evictions() == 1);
+        REQUIRE(cache.memory_usage() == 8 * sizeof(index_t));
+        REQUIRE(cache.get<array_1d<index_t>>(t, "1") == r1);
+        REQUIRE(cache.get<array_1d<index_t>>(t, "2") == nullptr);
+
+        // results larger than the limit are not stored
+        cache.get_or_compute<array_1d<index_t>>(t, "4", []() { return array_1d<index_t>::from_shape({11}); });
+        REQUIRE(cache.num_entries() == 2);
+        REQUIRE(cache.get<array_1d<index_t>>(t, "4") == nullptr);
+
+        cache.set_memory_limit(5 * sizeof(index_t));
+        REQUIRE(cache.num_entries() == 1);
+        REQUIRE(cache.evictions() == 2);
+
+        cache.set_memory_limit(0);
+        REQUIRE(!cache.enabled());
+        REQUIRE(cache.num_entries() == 0);
+        cache.get_or_compute<array_1d<index_t>>(t, "1", compute);
+        REQUIRE(cache.num_entries() == 0);
+
+        cache.set_memory_limit(10 * sizeof(index_t));
+        cache.set_enabled(false);
+        cache.get_or_compute<array_1d<index_t>>(t, "1", compute);
+        REQUIRE(cache.num_entries() == 0);
+        cache.set_enabled(true);
+        cache.get_or_compute<array_1d<index_t>>(t, "1", compute);
+        REQUIRE(cache.num_entries() == 1);
+    }
+
+    TEST_CASE("cached tree results", "[result_cache]") {
+        tree t(array_1d<index_t>{5, 5, 6, 6, 6, 7, 7, 7});
+
+        auto lca1 = cached_lca_fast(t);
+        auto lca2 = cached_lca_fast(t);
+        REQUIRE(lca1 == lca2);
+        REQUIRE(lca1->lca(0, 3) == 7);
+        REQUIRE(lca1->lca(2, 3) == 6);
+
+        auto area1 = cached_attribute_area(t);
+        auto area2 = cached_attribute_area(t);
+        REQUIRE(area1 == area2);
+        REQUIRE((*area1 == attribute_area(t)));
+
+        result_cache::global().invalidate(t);
+        REQUIRE(cached_lca_fast(t) != lca1);
+        // previous results are still usable
+        REQUIRE(lca1->lca(0, 1) == 5);
+    }
+
+    TEST_CASE("cached region adjacency graph", "[result_cache]") {
+        auto g = get_4_adjacency_graph({2, 3});
+        array_1d<index_t> labels1{1, 1, 2, 1, 3, 3};
+        array_1d<index_t> labels2{1, 1, 1, 2, 2, 2};
+
+        auto rag1 = cached_region_adjacency_graph_from_labelisation(g, labels1);
+        auto rag2 = cached_region_adjacency_graph_from_labelisation(g, labels1);
+        REQUIRE(rag1 == rag2);
+        auto ref1 = make_region_adjacency_graph_from_labelisation(g, labels1);
+        REQUIRE((rag1->vertex_map == ref1.vertex_map));
+        REQUIRE((rag1->edge_map == ref1.edge_map));
+        REQUIRE(num_vertices(rag1->rag) == num_vertices(ref1.rag));
+        REQUIRE(num_edges(rag1->rag) == num_edges(ref1.rag));
+
+        // a different labelisation is recomputed
+        auto rag3 = cached_region_adjacency_graph_from_labelisation(g, labels2);
+        REQUIRE(rag3 != rag1);
+        auto ref2 = make_region_adjacency_graph_from_labelisation(g, labels2);
+        REQUIRE((rag3->vertex_map == ref2.vertex_map));
+        REQUIRE((rag3->edge_map == ref2.edge_map));
+        REQUIRE((rag1->vertex_map == ref1.vertex_map));
+    }
+}
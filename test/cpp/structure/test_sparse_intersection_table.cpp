@@ -0,0 +1,77 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/structure/sparse_intersection_table.hpp"
+#include "../test_utils.hpp"
+
+namespace test_sparse_intersection_table {
+
+    using namespace hg;
+    using namespace std;
+
+    TEST_CASE("sparse intersection table", "[sparse_intersection_table]") {
+        array_1d<int> rows{0, 0, 2, 2, 2, 0, 3, 3};
+        array_1d<int> cols{1, 1, 0, 4, 0, 3, 4, 4};
+
+        auto table = make_sparse_intersection_table(rows, cols);
+        REQUIRE(table.num_rows() == 4);
+        REQUIRE(table.num_columns == 5);
+        REQUIRE(table.num_non_zeros() == 5);
+
+        array_1d<index_t> ref_row_begin{0, 2, 2, 4, 5};
+        array_1d<index_t> ref_columns{1, 3, 0, 4, 4};
+        array_1d<index_t> ref_values{2, 1, 2, 1, 2};
+        REQUIRE((table.row_begin == ref_row_begin));
+        REQUIRE((table.columns == ref_columns));
+        REQUIRE((table.values == ref_values));
+
+        array_2d<index_t> ref_dense{{0, 2, 0, 1, 0},
+                                    {0, 0, 0, 0, 0},
+                                    {2, 0, 0, 0, 1},
+                                    {0, 0, 0, 0, 2}};
+        REQUIRE((table.to_dense() == ref_dense));
+
+        array_1d<index_t> ref_row_sums{3, 0, 3, 2};
+        REQUIRE((table.row_sums() == ref_row_sums));
+
+        auto table2 = make_sparse_intersection_table<double>(rows, cols, 6, 7);
+        REQUIRE(table2.num_rows() == 6);
+        REQUIRE(table2.num_columns == 7);
+        REQUIRE(table2.num_non_zeros() == 5);
+        REQUIRE((xt::view(table2.to_dense(), xt::range(0, 4), xt::range(0, 5)) == ref_dense));
+    }
+
+    TEST_CASE("accumulate sparse intersection table", "[sparse_intersection_table]") {
+        auto t = tree(array_1d<index_t>{5, 5, 6, 6, 6, 7, 7, 7});
+        array_1d<int> leaves{0, 1, 2, 3, 4, 0, 1, 2, 3, 4};
+        array_1d<int> gt{0, 2, 2, 1, 0, 0, 0, 1, 1, 2};
+
+        auto leaf_table = make_sparse_intersection_table(leaves, gt);
+        auto table = accumulate_sparse_intersection_table(t, leaf_table);
+
+        REQUIRE(table.num_rows() == 8);
+        REQUIRE(table.num_columns == 3);
+
+        array_2d<index_t> ref{{2, 0, 0},
+                              {1, 0, 1},
+                              {0, 1, 1},
+                              {0, 2, 0},
+                              {1, 0, 1},
+                              {3, 0, 1},
+                              {1, 3, 2},
+                              {4, 3, 3}};
+        REQUIRE((table.to_dense() == ref));
+        for (index_t i = 0; i < table.num_rows(); i++) {
+            for (index_t k = table.row_begin(i) + 1; k < table.row_begin(i + 1); k++) {
+                REQUIRE(table.columns(k - 1) < table.columns(k));
+            }
+        }
+    }
+}
@@ -299,6 +299,36 @@ namespace tree {
         REQUIRE((child(1, vertices, g) == ref_child1));
     }
 
+    TEST_CASE("tree children interleaved", "[tree]") {
+        hg::tree t(array_1d<index_t>{8, 9, 8, 10, 9, 8, 10, 9, 10, 10, 10});
+
+        vector<vector<index_t>> ref{
+                {0, 2, 5},
+                {1, 4, 7},
+                {3, 6, 8, 9}
+        };
+        REQUIRE(num_leaves(t) == 8);
+        for (index_t v = 0; v < 8; v++) {
+            REQUIRE(num_children(v, t) == 0);
+            REQUIRE(t.children_cbegin(v) == t.children_cend(v));
+        }
+        for (index_t v = 8; v < 11; v++) {
+            vector<index_t> test;
+            for (auto c: hg::children_iterator(v, t)) {
+                test.push_back(c);
+            }
+            REQUIRE(vectorEqual(ref[v - 8], test));
+            REQUIRE(vectorEqual(ref[v - 8], t.children(v)));
+            REQUIRE(num_children(v, t) == ref[v - 8].size());
+            REQUIRE(child(ref[v - 8].size() - 1, v, t) == ref[v - 8].back());
+        }
+
+        hg::tree t2(array_1d<index_t>{0});
+        REQUIRE(num_leaves(t2) == 1);
+        REQUIRE(num_children(0, t2) == 0);
+        REQUIRE(t2.children_cbegin(0) == t2.children_cend(0));
+    }
+
     TEST_CASE("tree tree topological order iterator", "[tree]") {
         auto tree = data.t;
 
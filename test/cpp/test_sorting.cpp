@@ -0,0 +1,87 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "test_utils.hpp"
+#include "higra/sorting.hpp"
+#include "xtensor/xrandom.hpp"
+
+using namespace hg;
+
+namespace test_sorting {
+
+    template<typename T>
+    array_1d<index_t> reference_stable_arg_sort(const T &values, bool descending) {
+        array_1d<index_t> res = xt::arange<index_t>((index_t) values.size());
+        if (descending) {
+            std::stable_sort(res.begin(), res.end(), [&values](index_t i, index_t j) { return values(i) > values(j); });
+        } else {
+            std::stable_sort(res.begin(), res.end(), [&values](index_t i, index_t j) { return values(i) < values(j); });
+        }
+        return res;
+    }
+
+    template<typename T>
+    void check_stable_arg_sort(const T &values) {
+        REQUIRE((stable_arg_sort(values) == reference_stable_arg_sort(values, false)));
+        REQUIRE((stable_arg_sort(values, true) == reference_stable_arg_sort(values, true)));
+    }
+
+    TEST_CASE("stable_arg_sort small", "[sorting]") {
+        array_1d<double> v{3, 1, 2, 1, 3, 0};
+        REQUIRE((stable_arg_sort(v) == array_1d<index_t>{5, 1, 3, 2, 0, 4}));
+        REQUIRE((stable_arg_sort(v, true) == array_1d<index_t>{0, 4, 2, 1, 3, 5}));
+
+        array_1d<bool> vb{true, false, true, false};
+        REQUIRE((stable_arg_sort(vb) == array_1d<index_t>{1, 3, 0, 2}));
+
+        array_1d<int> ve = xt::empty<int>({0});
+        REQUIRE(stable_arg_sort(ve).size() == 0);
+    }
+
+    TEST_CASE("stable_arg_sort radix integral", "[sorting]") {
+        xt::random::seed(42);
+        size_t size = 100000;
+        check_stable_arg_sort(array_1d<uint8_t>(xt::random::randint<int>({size}, 0, 256)));
+        check_stable_arg_sort(array_1d<int8_t>(xt::random::randint<int>({size}, -128, 128)));
+        check_stable_arg_sort(array_1d<uint16_t>(xt::random::randint<int>({size}, 0, 65536)));
+        check_stable_arg_sort(array_1d<int16_t>(xt::random::randint<int>({size}, -1000, 1000)));
+        check_stable_arg_sort(array_1d<int32_t>(xt::random::randint<int>({size}, -100000, 100000)));
+        check_stable_arg_sort(array_1d<uint32_t>(xt::random::randint<uint32_t>({size}, 0, 4000000000u)));
+        check_stable_arg_sort(array_1d<int64_t>(xt::random::randint<int64_t>({size}, -(1ll << 40), 1ll << 40)));
+        check_stable_arg_sort(array_1d<uint64_t>(xt::random::randint<uint64_t>({size}, 0, 1ull << 50)));
+        // constant array
+        check_stable_arg_sort(array_1d<int32_t>(xt::ones<int32_t>({size})));
+    }
+
+    TEST_CASE("stable_arg_sort radix floating point", "[sorting]") {
+        xt::random::seed(42);
+        size_t size = 100000;
+        array_1d<float> vf = xt::random::rand<float>({size}, -10, 10);
+        check_stable_arg_sort(vf);
+
+        array_1d<double> vd = xt::random::randn<double>({size});
+        check_stable_arg_sort(vd);
+
+        // many ties including -0 and +0
+        array_1d<double> vt = xt::floor(xt::random::rand<double>({size}, -3, 3));
+        for (index_t i = 0; i < (index_t) size; i += 7) {
+            vt(i) = (i % 2 == 0) ? -0.0 : 0.0;
+        }
+        check_stable_arg_sort(vt);
+        check_stable_arg_sort(array_1d<float>(vt));
+    }
+
+    TEST_CASE("stable_arg_sort views", "[sorting]") {
+        xt::random::seed(42);
+        array_1d<int> v = xt::random::randint<int>({5000}, 0, 50);
+        auto view = xt::view(v, xt::range(1000, 4000));
+        check_stable_arg_sort(view);
+    }
+}
@@ -74,7 +74,7 @@ class TestTreeEnergyOptimization(unittest.TestCase):
 
         tree, altitudes = hg.binary_partition_tree_MumfordShah_energy(
             g, vertex_values)
-        ref_parents = (10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16)
+        ref_parents = (9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16)
         ref_altitudes = (0., 0., 0.,
                          0., 0., 0.,
                          0., 0., 0.,
@@ -91,7 +91,7 @@ class TestTreeEnergyOptimization(unittest.TestCase):
 
         tree, altitudes = hg.binary_partition_tree_MumfordShah_energy(
             g, vertex_values)
-        ref_parents = (10, 10, 11, 14, 13, 11, 12, 9, 9, 12, 13, 16, 15, 14, 15, 16, 16)
+        ref_parents = (9, 9, 11, 14, 10, 11, 12, 12, 13, 10, 14, 16, 13, 15, 15, 16, 16)
         ref_altitudes = (0., 0., 0.,
                          0., 0., 0.,
                          0., 0., 0.,
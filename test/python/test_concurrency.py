@@ -0,0 +1,98 @@
+############################################################################
+# Copyright ESIEE Paris (2019)                                             #
+#                                                                          #
+# Contributor(s) : Benjamin Perret                                         #
+#                                                                          #
+# Distributed under the terms of the CECILL-B License.                     #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+import unittest
+import threading
+import higra as hg
+import numpy as np
+
+
+class TestConcurrency(unittest.TestCase):
+
+    @staticmethod
+    def run_algorithms(image):
+        size = image.shape
+        graph = hg.get_4_adjacency_graph(size)
+        edge_weights = hg.weight_graph(graph, image, hg.WeightFunction.L1)
+
+        results = []
+        tree, altitudes = hg.bpt_canonical(graph, edge_weights)
+        results.append((tree.parents(), altitudes))
+
+        tree, altitudes = hg.quasi_flat_zone_hierarchy(graph, edge_weights)
+        results.append((tree.parents(), altitudes))
+
+        tree, altitudes = hg.binary_partition_tree_average_linkage(graph, edge_weights)
+        results.append((tree.parents(), altitudes))
+
+        tree, altitudes = hg.watershed_hierarchy_by_area(graph, edge_weights)
+        results.append((tree.parents(), altitudes))
+
+        tree, altitudes = hg.watershed_hierarchy_by_volume(graph, edge_weights)
+        results.append((tree.parents(), altitudes))
+
+        tree, altitudes = hg.watershed_hierarchy_by_dynamics(graph, edge_weights)
+        results.append((tree.parents(), altitudes))
+
+        tree, altitudes = hg.component_tree_max_tree(graph, image)
+        results.append((tree.parents(), altitudes, hg.attribute_area(tree)))
+
+        tree, altitudes = hg.component_tree_tree_of_shapes_image2d(image)
+        results.append((tree.parents(), altitudes))
+
+        return results
+
+    def test_concurrent_calls(self):
+        np.random.seed(42)
+        images = [np.random.randint(0, 32, (40, 50)).astype(np.float64) for _ in range(8)]
+        expected = [TestConcurrency.run_algorithms(image) for image in images]
+
+        num_threads = 4
+        results = [[None] * len(images) for _ in range(num_threads)]
+        errors = []
+
+        def work(thread_id):
+            try:
+                for repeat in range(3):
+                    for i, image in enumerate(images):
+                        results[thread_id][i] = TestConcurrency.run_algorithms(image)
+            except Exception as e:  # pragma: no cover
+                errors.append(e)
+
+        threads = [threading.Thread(target=work, args=(t,)) for t in range(num_threads)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+
+        self.assertTrue(len(errors) == 0, str(errors))
+        for thread_results in results:
+            for res, ref in zip(thread_results, expected):
+                for arrays, ref_arrays in zip(res, ref):
+                    for a, r in zip(arrays, ref_arrays):
+                        self.assertTrue(np.all(a == r))
+
+    def test_watershed_hierarchy_functor_exception(self):
+        # the attribute functor is called after the GIL has been released by the binding
+        graph = hg.get_4_adjacency_graph((4, 5))
+        edge_weights = np.arange(graph.num_edges(), dtype=np.float64)
+
+        def functor(tree, altitudes):
+            raise ValueError("error in attribute functor")
+
+        with self.assertRaises(Exception):
+            hg.watershed_hierarchy_by_attribute(graph, edge_weights, functor)
+
+        tree, altitudes = hg.watershed_hierarchy_by_area(graph, edge_weights)
+        self.assertTrue(tree.num_leaves() == graph.num_vertices())
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -9,6 +9,7 @@
 ############################################################################
 
 import unittest
+import numpy as np
 import higra as hg
 
 
@@ -245,6 +246,33 @@ class TestDataCache(unittest.TestCase):
         self.assertTrue(default_attr(obj1, 1) == 4)
         self.assertRaises(Exception, default_attr, obj1, 1, force_recompute=True)
 
+    def test_result_cache(self):
+        hg.clear_auto_cache()
+        hg.reset_result_cache_statistics()
+        tree = hg.Tree((5, 5, 6, 6, 6, 7, 7, 7))
+
+        lca1 = tree.lowest_common_ancestor_preprocess()
+        stats = hg.get_result_cache_statistics()
+        self.assertTrue(stats["misses"] == 1)
+        self.assertTrue(stats["num_entries"] == 1)
+        self.assertTrue(stats["memory_usage"] > 0)
+
+        hg.clear_attributes(tree, "lca_fast")
+        lca2 = tree.lowest_common_ancestor_preprocess()
+        self.assertTrue(hg.get_result_cache_statistics()["hits"] == 1)
+        self.assertTrue(np.all(lca1.lca((0, 2), (1, 3)) == lca2.lca((0, 2), (1, 3))))
+
+        hg.clear_auto_cache(reference_object=tree)
+        self.assertTrue(hg.get_result_cache_statistics()["num_entries"] == 0)
+
+        limit = hg.get_result_cache_memory_limit()
+        hg.set_result_cache_memory_limit(0)
+        hg.clear_attributes(tree, "lca_fast")
+        tree.lowest_common_ancestor_preprocess()
+        self.assertTrue(hg.get_result_cache_statistics()["num_entries"] == 0)
+        hg.set_result_cache_memory_limit(limit)
+        self.assertTrue(hg.get_result_cache_memory_limit() == limit)
+
 
 if __name__ == '__main__':
     unittest.main()
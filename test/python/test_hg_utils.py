@@ -176,3 +176,14 @@ class TestHGUtils(unittest.TestCase):
             res = hg.reconstruct_leaf_data(tree, a)
             self.assertTrue(a.dtype == res.dtype)
 
+
+    def test_index_type(self):
+        self.assertTrue(hg.index_t in (np.int32, np.int64))
+
+        tree = hg.Tree(np.asarray((5, 5, 6, 6, 6, 7, 7, 7), dtype=hg.index_t))
+        self.assertTrue(tree.parents().dtype == hg.index_t)
+
+        g = hg.get_4_adjacency_graph((2, 3))
+        sources, targets = g.edge_list()
+        self.assertTrue(sources.dtype == hg.index_t)
+        self.assertTrue(targets.dtype == hg.index_t)
@@ -85,6 +85,24 @@ class TestBinaryPartitionTree(unittest.TestCase):
         self.assertTrue(np.all(expected_parents == tree.parents()))
         self.assertTrue(np.allclose(expected_altitudes, altitudes))
 
+    def test_binary_partition_tree_reciprocal_nearest_neighbours(self):
+        np.random.seed(1)
+        graph = hg.get_4_adjacency_graph((10, 12))
+        edge_values = np.random.rand(graph.num_edges())
+        edge_weights = np.random.randint(1, 10, graph.num_edges()).astype(np.float64)
+
+        tree1, altitudes1 = hg.binary_partition_tree_complete_linkage(graph, edge_values)
+        tree2, altitudes2 = hg.binary_partition_tree_complete_linkage(
+            graph, edge_values, algorithm=hg.BptLinkageAlgorithm.reciprocal_nearest_neighbours)
+        self.assertTrue(np.all(tree1.parents() == tree2.parents()))
+        self.assertTrue(np.all(altitudes1 == altitudes2))
+
+        tree1, altitudes1 = hg.binary_partition_tree_average_linkage(graph, edge_values, edge_weights)
+        tree2, altitudes2 = hg.binary_partition_tree_average_linkage(
+            graph, edge_values, edge_weights, algorithm=hg.BptLinkageAlgorithm.reciprocal_nearest_neighbours)
+        self.assertTrue(np.all(tree1.parents() == tree2.parents()))
+        self.assertTrue(np.allclose(altitudes1, altitudes2))
+
     def test_binary_partition_tree_ward_linkage(self):
         graph = hg.UndirectedGraph(5)
 
@@ -63,6 +63,17 @@ class TestConstrainedConnectivityHierarchy(unittest.TestCase):
         self.assertTrue(np.all(expected_parents == tree.parents()))
         self.assertTrue(np.allclose(expected_altitudes, altitudes))
 
+    def test_component_tree_algorithms(self):
+        np.random.seed(1)
+        graph = hg.get_8_adjacency_graph((40, 30))
+        vertex_weights = np.random.randint(0, 10, (40, 30))
+        for fun in (hg.component_tree_min_tree, hg.component_tree_max_tree):
+            tree_ref, altitudes_ref = fun(graph, vertex_weights, hg.ComponentTreeAlgorithm.sequential)
+            for algorithm in (hg.ComponentTreeAlgorithm.parallel, hg.ComponentTreeAlgorithm.automatic):
+                tree, altitudes = fun(graph, vertex_weights, algorithm)
+                self.assertTrue(np.all(tree_ref.parents() == tree.parents()))
+                self.assertTrue(np.all(altitudes_ref == altitudes))
+
     def test_area_filter_max_tree(self):
         graph = hg.get_4_adjacency_implicit_graph((5, 5))
         vertex_weights = np.asarray(((-5, 2, 2, 5, 5),
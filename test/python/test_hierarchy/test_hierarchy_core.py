@@ -64,6 +64,25 @@ class TestHierarchyCore(unittest.TestCase):
 
         self.assertTrue(np.all(mst_edge_map == (1, 0, 3, 4, 2)))
 
+    def test_BPT_algorithms(self):
+        np.random.seed(1)
+        graph = hg.get_4_adjacency_graph((23, 17))
+        # many ties to check that ties are broken in the same way by all algorithms
+        edge_weights = np.random.randint(0, 5, graph.num_edges())
+
+        tree_k, altitudes_k = hg.bpt_canonical(graph, edge_weights, hg.BptAlgorithm.kruskal)
+        mst_k = hg.CptBinaryHierarchy.construct(tree_k)["mst"]
+        mst_edge_map_k = hg.get_attribute(mst_k, "mst_edge_map")
+
+        for algorithm in (hg.BptAlgorithm.boruvka, hg.BptAlgorithm.automatic):
+            tree, altitudes = hg.bpt_canonical(graph, edge_weights, algorithm=algorithm)
+            mst = hg.CptBinaryHierarchy.construct(tree)["mst"]
+            mst_edge_map = hg.get_attribute(mst, "mst_edge_map")
+
+            self.assertTrue(np.all(tree.parents() == tree_k.parents()))
+            self.assertTrue(np.all(altitudes == altitudes_k))
+            self.assertTrue(np.all(mst_edge_map == mst_edge_map_k))
+
     def test_QFZ(self):
         graph = hg.get_4_adjacency_graph((2, 3))
 
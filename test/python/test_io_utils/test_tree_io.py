@@ -56,6 +56,42 @@ class TestTreeIO(unittest.TestCase):
 
         self.assertTrue(np.allclose(tree.parents(), parents))
 
+    def test_treeReadWriteBinary(self):
+        filename = "testTreeIO.bin"
+        silent_remove(filename)
+
+        parents = np.asarray((5, 5, 6, 6, 6, 7, 7, 7), dtype=np.int64)
+        tree = hg.Tree(parents)
+
+        attr1 = np.asarray((1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0))
+        attr2 = np.asarray((8, 7, 6, 5, 4, 3, 2, 1), dtype=np.int32)
+        attr3 = np.arange(16, dtype=np.uint8)[::2]
+
+        hg.save_tree_binary(filename, tree, {"attr1": attr1, "attr2": attr2, "attr3": attr3})
+
+        tree2, attributes = hg.read_tree_binary(filename)
+
+        self.assertTrue(np.all(tree2.parents() == parents))
+
+        for name, attr in (("attr1", attr1), ("attr2", attr2), ("attr3", attr3)):
+            self.assertTrue(name in attributes)
+            self.assertTrue(attributes[name].dtype == attr.dtype)
+            self.assertTrue(np.all(attributes[name] == attr))
+            self.assertFalse(attributes[name].flags.writeable)
+            self.assertTrue(np.all(hg.get_attribute(tree2, name) == attr))
+
+        del tree2, attributes
+        silent_remove(filename)
+
+        # Test without attributes
+        hg.save_tree_binary(filename, tree)
+
+        tree2, attributes = hg.read_tree_binary(filename)
+        silent_remove(filename)
+
+        self.assertTrue(np.all(tree2.parents() == parents))
+        self.assertTrue(len(attributes) == 0)
+
     def test_print_partition_tree(self):
         tree = hg.Tree((5, 5, 6, 6, 6, 7, 7, 7))
         s = hg.print_partition_tree(tree, altitudes=np.asarray([0, 0, 0, 0, 0, 100, 1100, 20000]),